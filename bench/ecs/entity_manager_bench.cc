@@ -0,0 +1,144 @@
+/**
+ * @file entity_manager_bench.cc
+ * @brief Measures how the RecycleOrder of destroyed entity IDs affects
+ * iteration over component pools.
+ *
+ * @details
+ * Every benchmark churns a world first: it creates kWorldSize entities,
+ * destroys most of them in random order and then creates kLiveCount new ones,
+ * which receive recycled IDs. A View then visits the new entities through the
+ * packed array of one pool and the sparse index of the other, so the order of
+ * the recycled IDs decides how scattered the sparse lookups are.
+ *
+ * BM_RecycleLowAndHigh measures the cost of recycling itself when the free
+ * IDs lie at both ends of a large ID range.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "src/ecs/coordinator/coordinator.h"
+#include "src/ecs/entity_manager/entity_manager.h"
+
+namespace {
+
+constexpr size_t kWorldSize = 1 << 21;
+constexpr size_t kLiveCount = kWorldSize / 8;
+
+struct BenchPosition {
+  float x;
+  float y;
+};
+
+struct BenchVelocity {
+  float dx;
+  float dy;
+};
+
+/// @brief Builds a Coordinator whose live entities all use recycled IDs.
+std::unique_ptr<ecs::Coordinator> MakeChurnedWorld(
+    ecs::RecycleOrder recycle_order) {
+  // Keep the Coordinator's console setup out of the benchmark output
+  std::streambuf* cout_buffer = std::cout.rdbuf();
+  std::ostringstream discarded;
+  std::cout.rdbuf(discarded.rdbuf());
+  auto coordinator = std::make_unique<ecs::Coordinator>();
+  std::cout.rdbuf(cout_buffer);
+
+  coordinator->set_recycle_order(recycle_order);
+  coordinator->RegisterComponentType<BenchPosition>();
+  coordinator->RegisterComponentType<BenchVelocity>();
+
+  std::vector<ecs::Entity> entities = coordinator->CreateEntities(kWorldSize);
+  std::shuffle(entities.begin(), entities.end(), std::mt19937(42));
+  for (ecs::Entity entity : entities) {
+    coordinator->DestroyEntity(entity);
+  }
+
+  for (size_t i = 0; i < kLiveCount; ++i) {
+    ecs::Entity entity = coordinator->CreateEntity();
+    coordinator->AddComponent(entity, BenchPosition{0.0f, 0.0f});
+    coordinator->AddComponent(entity, BenchVelocity{1.0f, 1.0f});
+  }
+
+  return coordinator;
+}
+
+void BM_ViewAfterChurn(benchmark::State& state) {
+  auto recycle_order = static_cast<ecs::RecycleOrder>(state.range(0));
+  std::unique_ptr<ecs::Coordinator> coordinator =
+      MakeChurnedWorld(recycle_order);
+
+  for (auto _ : state) {
+    coordinator->View<BenchPosition, BenchVelocity>().each(
+        [](ecs::Entity, BenchPosition& position,
+           const BenchVelocity& velocity) {
+          position.x += velocity.dx;
+          position.y += velocity.dy;
+        });
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kLiveCount));
+}
+
+void BM_CreateDestroyChurn(benchmark::State& state) {
+  ecs::EntityManager entity_manager;
+  entity_manager.set_recycle_order(
+      static_cast<ecs::RecycleOrder>(state.range(0)));
+  std::vector<ecs::Entity> entities = entity_manager.CreateEntities(kLiveCount);
+
+  for (auto _ : state) {
+    for (ecs::Entity& entity : entities) {
+      entity_manager.DestroyEntity(entity);
+      entity = entity_manager.CreateEntity();
+    }
+    benchmark::DoNotOptimize(entities.data());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kLiveCount));
+}
+
+void BM_RecycleLowAndHigh(benchmark::State& state) {
+  ecs::EntityManager entity_manager;
+  entity_manager.set_recycle_order(
+      static_cast<ecs::RecycleOrder>(state.range(0)));
+  entity_manager.CreateEntities(kWorldSize);
+
+  // Frees the lowest and the highest ID, so that kLowestFirst has a free ID
+  // at both ends of the range on every create
+  ecs::Entity low = 0;
+  ecs::Entity high = kWorldSize - 1;
+  for (auto _ : state) {
+    entity_manager.DestroyEntity(low).DestroyEntity(high);
+    low = entity_manager.CreateEntity();
+    high = entity_manager.CreateEntity();
+    benchmark::DoNotOptimize(high);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 2);
+}
+
+void RecycleOrders(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgName("recycle_order");
+  for (ecs::RecycleOrder recycle_order :
+       {ecs::RecycleOrder::kFifo, ecs::RecycleOrder::kLifo,
+        ecs::RecycleOrder::kLowestFirst}) {
+    benchmark->Arg(static_cast<int64_t>(recycle_order));
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_ViewAfterChurn)->Apply(RecycleOrders);
+BENCHMARK(BM_CreateDestroyChurn)->Apply(RecycleOrders);
+BENCHMARK(BM_RecycleLowAndHigh)->Apply(RecycleOrders);
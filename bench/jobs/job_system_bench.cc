@@ -0,0 +1,113 @@
+/**
+ * @file job_system_bench.cc
+ * @brief Compares the JobSystem with starting a thread per task.
+ *
+ * @details
+ * Every benchmark runs the same per-element work over kElementCount floats,
+ * split into chunks of state.range(0) elements. The baseline starts a
+ * std::thread per chunk, the way systems were parallelized before the
+ * JobSystem existed, so small chunks show the cost of thread creation that the
+ * persistent workers avoid.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "src/jobs/job_system.h"
+
+namespace {
+
+constexpr size_t kElementCount = 1 << 20;
+
+/// @brief Work of a typical system on one element.
+void Update(std::vector<float>& values, size_t begin, size_t end) {
+  for (size_t i = begin; i < end; ++i) {
+    values[i] = std::sqrt(values[i] * values[i] + 1.0f);
+  }
+}
+
+void BM_ThreadPerTask(benchmark::State& state) {
+  size_t grain_size = static_cast<size_t>(state.range(0));
+  std::vector<float> values(kElementCount, 1.0f);
+
+  for (auto _ : state) {
+    std::vector<std::thread> threads;
+    for (size_t begin = 0; begin < kElementCount; begin += grain_size) {
+      size_t end = std::min(begin + grain_size, kElementCount);
+      threads.emplace_back([&values, begin, end] {
+        Update(values, begin, end);
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kElementCount));
+}
+
+void BM_ParallelFor(benchmark::State& state) {
+  size_t grain_size = static_cast<size_t>(state.range(0));
+  std::vector<float> values(kElementCount, 1.0f);
+  tbge::jobs::JobSystem job_system;
+
+  for (auto _ : state) {
+    tbge::jobs::ParallelFor(job_system, 0, kElementCount, grain_size,
+                            [&values](size_t begin, size_t end) {
+                              Update(values, begin, end);
+                            });
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kElementCount));
+}
+
+void BM_RecursiveTaskGroup(benchmark::State& state) {
+  size_t grain_size = static_cast<size_t>(state.range(0));
+  std::vector<float> values(kElementCount, 1.0f);
+  tbge::jobs::JobSystem job_system;
+
+  // Splits the range in halves, so the workers steal large halves from each
+  // other instead of taking every chunk from the caller
+  auto split = [&](auto& self, size_t begin, size_t end) -> void {
+    if (end - begin <= grain_size) {
+      Update(values, begin, end);
+      return;
+    }
+    size_t middle = begin + (end - begin) / 2;
+    tbge::jobs::TaskGroup group(job_system);
+    group.Run([&self, begin, middle] { self(self, begin, middle); });
+    self(self, middle, end);
+    group.Wait();
+  };
+
+  for (auto _ : state) {
+    split(split, 0, kElementCount);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(kElementCount));
+}
+
+void GrainSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgName("grain_size");
+  for (int64_t grain_size : {1 << 12, 1 << 14, 1 << 16}) {
+    benchmark->Arg(grain_size);
+  }
+  benchmark->UseRealTime();
+}
+
+}  // namespace
+
+BENCHMARK(BM_ThreadPerTask)->Apply(GrainSizes);
+BENCHMARK(BM_ParallelFor)->Apply(GrainSizes);
+BENCHMARK(BM_RecursiveTaskGroup)->Apply(GrainSizes);
@@ -8,6 +8,7 @@ HELP=0
 DEBUG=0
 DOC=0
 RELEASE=0
+BENCH=0
 CLS=0
 CLS_AFTER=0
 TARGET=""
@@ -40,6 +41,9 @@ for arg in "$@"; do
     --release)
       RELEASE=1
       ;;
+    -b|--bench)
+      BENCH=1
+      ;;
     --cls)
       CLS=1
       ;;
@@ -63,6 +67,12 @@ if [[ $TEST -eq 1 ]]; then
   DEBUG=1;
 fi
 
+if [[ $BENCH -eq 1 ]]; then
+  RELEASE=1
+  RUN=1
+  [[ -z "$TARGET" ]] && TARGET="tbge_benchmark"
+fi
+
 echo "CLEAN=$CLEAN"
 echo "TEST=$TEST"
 echo "RUN=$RUN"
@@ -71,6 +81,7 @@ echo "HELP=$HELP"
 echo "DEBUG=$DEBUG"
 echo "CLS=$CLS"
 echo "RELEASE=$RELEASE"
+echo "BENCH=$BENCH"
 echo "TARGET=$TARGET"
 
 BAZEL_FLAGS=""
@@ -101,6 +112,7 @@ Options:
   -r, --run           Run the main target.
   -d, --debug         Build in debug mode.
   --release           Build in release mode.
+  -b, --bench         Build and run the benchmarks in release mode.
   --target=TARGET     Specify a custom Bazel target (default: //:tbge_main, or //:tbge_test with --test).
 Description:
   This script automates the build process for the project.
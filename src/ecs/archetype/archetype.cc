@@ -0,0 +1,154 @@
+#include "src/ecs/archetype/archetype.h"
+
+#include <absl/log/check.h>
+
+#include <algorithm>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "src/ecs/context/context.h"
+
+namespace ecs {
+
+namespace {
+
+size_t AlignUp(size_t offset, size_t alignment) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+Archetype::Archetype(const Signature& signature,
+                     std::pmr::vector<ComponentTypeId> component_types,
+                     std::pmr::vector<const ComponentTypeInfo*> type_infos,
+                     std::pmr::memory_resource* resource)
+    : signature_(signature),
+      component_types_(std::move(component_types), resource),
+      type_infos_(std::move(type_infos), resource),
+      column_of_type_(resource),
+      column_offsets_(resource),
+      chunks_(resource),
+      add_edges_(resource),
+      remove_edges_(resource) {
+  CHECK(component_types_.size() == type_infos_.size())
+      << "Every archetype column needs a ComponentTypeInfo.";
+
+  // Map component type IDs to columns
+  for (size_t column = 0; column < component_types_.size(); ++column) {
+    ComponentTypeId type = component_types_[column];
+    if (type >= column_of_type_.size()) {
+      column_of_type_.resize(static_cast<size_t>(type) + 1, -1);
+    }
+    column_of_type_[type] = static_cast<int>(column);
+  }
+
+  chunk_alignment_ = alignof(std::max_align_t);
+  size_t row_bytes = sizeof(Entity);
+  for (const ComponentTypeInfo* info : type_infos_) {
+    chunk_alignment_ = std::max(chunk_alignment_, info->alignment);
+    row_bytes += info->size;
+  }
+
+  // Fit as many rows as possible into a chunk, allowing for column padding
+  chunk_capacity_ = std::max<size_t>(1, kArchetypeChunkSize / row_bytes);
+  while (chunk_capacity_ > 1 &&
+         layout_chunk(chunk_capacity_) > kArchetypeChunkSize) {
+    --chunk_capacity_;
+  }
+  chunk_bytes_ = layout_chunk(chunk_capacity_);
+}
+
+Archetype::~Archetype() {
+  for (size_t row = 0; row < size_; ++row) {
+    DestroyRow(row);
+  }
+}
+
+size_t Archetype::AppendRow(Entity entity) {
+  if (size_ == chunks_.size() * chunk_capacity_) {
+    std::pmr::memory_resource* resource = chunks_.get_allocator().resource();
+    auto* memory = static_cast<std::byte*>(
+        resource->allocate(chunk_bytes_, chunk_alignment_));
+    chunks_.emplace_back(
+        memory, ChunkDeleter{resource, chunk_bytes_, chunk_alignment_});
+  }
+
+  size_t row = size_++;
+  GetChunkEntities(row / chunk_capacity_)[row % chunk_capacity_] = entity;
+
+  return row;
+}
+
+Entity Archetype::EraseRow(size_t row) {
+  size_t last_row = size_ - 1;
+  Entity moved_entity = GetEntity(last_row);
+
+  // Move the last row into the erased one to keep the rows dense
+  if (row != last_row) {
+    for (size_t column = 0; column < type_infos_.size(); ++column) {
+      type_infos_[column]->relocate(GetComponent(column, row),
+                                    GetComponent(column, last_row));
+    }
+    GetChunkEntities(row / chunk_capacity_)[row % chunk_capacity_] =
+        moved_entity;
+  }
+
+  --size_;
+
+  // Free the last chunk once it no longer holds any rows
+  if (size_ == (chunks_.size() - 1) * chunk_capacity_) {
+    chunks_.pop_back();
+  }
+
+  return moved_entity;
+}
+
+Archetype& Archetype::DestroyRow(size_t row) {
+  for (size_t column = 0; column < type_infos_.size(); ++column) {
+    type_infos_[column]->destroy(GetComponent(column, row));
+  }
+
+  return *this;
+}
+
+Archetype* Archetype::GetAddEdge(ComponentTypeId component_type) const {
+  auto edge = add_edges_.find(component_type);
+  return edge != add_edges_.end() ? edge->second : nullptr;
+}
+
+Archetype& Archetype::SetAddEdge(ComponentTypeId component_type,
+                                 Archetype* archetype) {
+  add_edges_[component_type] = archetype;
+  return *this;
+}
+
+Archetype* Archetype::GetRemoveEdge(ComponentTypeId component_type) const {
+  auto edge = remove_edges_.find(component_type);
+  return edge != remove_edges_.end() ? edge->second : nullptr;
+}
+
+Archetype& Archetype::SetRemoveEdge(ComponentTypeId component_type,
+                                    Archetype* archetype) {
+  remove_edges_[component_type] = archetype;
+  return *this;
+}
+
+// #########################
+// #        PRIVATE        #
+// #########################
+size_t Archetype::layout_chunk(size_t capacity) {
+  // The entity array comes first, followed by one aligned column per type
+  size_t offset = sizeof(Entity) * capacity;
+
+  column_offsets_.resize(type_infos_.size());
+  for (size_t column = 0; column < type_infos_.size(); ++column) {
+    offset = AlignUp(offset, type_infos_[column]->alignment);
+    column_offsets_[column] = offset;
+    offset += type_infos_[column]->size * capacity;
+  }
+
+  return AlignUp(offset, chunk_alignment_);
+}
+
+}  // namespace ecs
@@ -0,0 +1,281 @@
+/**
+ * @file archetype.h
+ * @brief Chunked column storage for entities that share a Signature.
+ *
+ * @details
+ * Provides the Archetype class used by ArchetypeStorage. An archetype stores
+ * every entity with exactly the same set of component types, packed into
+ * fixed-size chunks with one column per component type.
+ */
+
+#ifndef TBGE_ECS_ARCHETYPE_H_
+#define TBGE_ECS_ARCHETYPE_H_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "src/ecs/context/context.h"
+
+namespace ecs {
+
+/**
+ * @brief Type-erased description of a component type.
+ *
+ * @details
+ * Archetypes store components as raw bytes, so they need the size, alignment
+ * and the operations to move and destroy values of each component type.
+ */
+struct ComponentTypeInfo {
+  /// @brief Name of the component type, used for log messages.
+  const char* name = nullptr;
+
+  /// @brief sizeof() the component type.
+  size_t size = 0;
+
+  /// @brief alignof() the component type.
+  size_t alignment = 0;
+
+  /// @brief Move-constructs the value at source into destination and destroys
+  /// the value at source.
+  void (*relocate)(void* destination, void* source) = nullptr;
+
+  /// @brief Destroys the value at object.
+  void (*destroy)(void* object) = nullptr;
+};
+
+/**
+ * @brief Builds the ComponentTypeInfo for the component type T.
+ *
+ * @tparam T The component type to describe.
+ * @return The ComponentTypeInfo describing T.
+ */
+template <typename T>
+ComponentTypeInfo MakeComponentTypeInfo() {
+  return ComponentTypeInfo{
+      typeid(T).name(), sizeof(T), alignof(T),
+      [](void* destination, void* source) {
+        T* value = static_cast<T*>(source);
+        ::new (destination) T(std::move(*value));
+        value->~T();
+      },
+      [](void* object) { static_cast<T*>(object)->~T(); }};
+}
+
+/**
+ * @class Archetype
+ * @brief Stores all entities that have exactly the same component types.
+ *
+ * @details
+ * Rows are packed into chunks of kArchetypeChunkSize bytes. Each chunk holds
+ * an array of entity IDs followed by one contiguous column per component type,
+ * so iterating an archetype is a linear walk over each chunk.
+ *
+ * Rows are kept dense: erasing a row moves the last row into its place.
+ *
+ * Archetypes also cache the archetype reached by adding or removing a single
+ * component type, so repeated transitions do not need a signature lookup.
+ */
+class Archetype {
+ public:
+  /**
+   * @brief Constructs an empty archetype.
+   *
+   * @param signature The signature shared by every entity in the archetype.
+   * @param component_types The component type IDs of the columns, in column
+   * order.
+   * @param type_infos The type information of each column, in column order.
+   * @param resource The memory resource chunks and bookkeeping are allocated
+   * from. Must outlive the archetype.
+   */
+  Archetype(
+      const Signature& signature,
+      std::pmr::vector<ComponentTypeId> component_types,
+      std::pmr::vector<const ComponentTypeInfo*> type_infos,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  /**
+   * @brief Destroys every stored component and frees all chunks.
+   */
+  ~Archetype();
+
+  Archetype(const Archetype&) = delete;
+  Archetype& operator=(const Archetype&) = delete;
+
+  /**
+   * @brief Appends a row for the entity.
+   *
+   * @note The component values of the new row are left uninitialized and must
+   * be constructed by the caller.
+   *
+   * @param entity The entity that owns the new row.
+   * @return The index of the new row.
+   */
+  size_t AppendRow(Entity entity);
+
+  /**
+   * @brief Erases a row whose component values have already been destroyed or
+   * relocated, moving the last row into its place.
+   *
+   * @param row The row to erase.
+   * @return The entity whose row moved into the erased row, or the entity of
+   * the erased row if it was the last one.
+   */
+  Entity EraseRow(size_t row);
+
+  /**
+   * @brief Destroys every component value in a row.
+   *
+   * @param row The row whose values are destroyed.
+   * @return Reference to the current Archetype for method chaining.
+   */
+  Archetype& DestroyRow(size_t row);
+
+  /**
+   * @brief Returns the column that stores the component type, or -1.
+   *
+   * @param component_type The component type ID to look up.
+   * @return The column index, or -1 if the archetype has no such column.
+   */
+  int GetColumn(ComponentTypeId component_type) const {
+    return component_type < column_of_type_.size()
+               ? column_of_type_[component_type]
+               : -1;
+  }
+
+  /**
+   * @brief Returns a pointer to a component value.
+   *
+   * @param column The column of the component.
+   * @param row The row of the component.
+   * @return A pointer to the start of the value.
+   */
+  void* GetComponent(size_t column, size_t row) {
+    return GetChunkColumn(row / chunk_capacity_, column) +
+           (row % chunk_capacity_) * type_infos_[column]->size;
+  }
+
+  /**
+   * @brief Returns the entity stored in a row.
+   *
+   * @param row The row to read.
+   * @return The entity that owns the row.
+   */
+  Entity GetEntity(size_t row) const {
+    return GetChunkEntities(row / chunk_capacity_)[row % chunk_capacity_];
+  }
+
+  /**
+   * @brief Returns the entity array of a chunk.
+   *
+   * @param chunk The chunk index.
+   * @return A pointer to the first entity in the chunk.
+   */
+  Entity* GetChunkEntities(size_t chunk) const {
+    return reinterpret_cast<Entity*>(chunks_[chunk].get());
+  }
+
+  /**
+   * @brief Returns the start of a column within a chunk.
+   *
+   * @param chunk The chunk index.
+   * @param column The column index.
+   * @return A pointer to the first value of the column in the chunk.
+   */
+  std::byte* GetChunkColumn(size_t chunk, size_t column) const {
+    return chunks_[chunk].get() + column_offsets_[column];
+  }
+
+  /**
+   * @brief Returns the number of rows stored in a chunk.
+   *
+   * @param chunk The chunk index.
+   * @return The number of used rows in the chunk.
+   */
+  size_t GetChunkSize(size_t chunk) const {
+    return chunk + 1 < chunks_.size() ? chunk_capacity_
+                                      : size_ - chunk * chunk_capacity_;
+  }
+
+  /// @brief Returns the cached archetype reached by adding a component type.
+  Archetype* GetAddEdge(ComponentTypeId component_type) const;
+
+  /// @brief Caches the archetype reached by adding a component type.
+  Archetype& SetAddEdge(ComponentTypeId component_type, Archetype* archetype);
+
+  /// @brief Returns the cached archetype reached by removing a component type.
+  Archetype* GetRemoveEdge(ComponentTypeId component_type) const;
+
+  /// @brief Caches the archetype reached by removing a component type.
+  Archetype& SetRemoveEdge(ComponentTypeId component_type,
+                           Archetype* archetype);
+
+  /// @brief Returns the signature shared by every entity in the archetype.
+  const Signature& get_signature() const { return signature_; }
+
+  /// @brief Returns the component type IDs of the columns, in column order.
+  const std::pmr::vector<ComponentTypeId>& get_component_types() const {
+    return component_types_;
+  }
+
+  /// @brief Returns the type information of a column.
+  const ComponentTypeInfo& get_type_info(size_t column) const {
+    return *type_infos_[column];
+  }
+
+  /// @brief Returns the number of rows stored in the archetype.
+  size_t get_size() const { return size_; }
+
+  /// @brief Returns the number of rows that fit in one chunk.
+  size_t get_chunk_capacity() const { return chunk_capacity_; }
+
+  /// @brief Returns the number of allocated chunks.
+  size_t get_chunk_count() const { return chunks_.size(); }
+
+ private:
+  /// @brief Returns a chunk to the resource it was allocated from.
+  struct ChunkDeleter {
+    std::pmr::memory_resource* resource;
+    size_t bytes;
+    size_t alignment;
+    void operator()(std::byte* chunk) const {
+      resource->deallocate(chunk, bytes, alignment);
+    }
+  };
+
+  Signature signature_;
+  std::pmr::vector<ComponentTypeId> component_types_;
+  std::pmr::vector<const ComponentTypeInfo*> type_infos_;
+
+  /// @brief Column index of each component type ID, or -1.
+  std::pmr::vector<int> column_of_type_;
+
+  /// @brief Byte offset of each column from the start of a chunk.
+  std::pmr::vector<size_t> column_offsets_;
+
+  /// @brief Rows per chunk and the byte size and alignment of a chunk.
+  size_t chunk_capacity_ = 0;
+  size_t chunk_bytes_ = 0;
+  size_t chunk_alignment_ = 0;
+
+  std::pmr::vector<std::unique_ptr<std::byte[], ChunkDeleter>> chunks_;
+
+  /// @brief Total number of rows across all chunks.
+  size_t size_ = 0;
+
+  std::pmr::unordered_map<ComponentTypeId, Archetype*> add_edges_;
+  std::pmr::unordered_map<ComponentTypeId, Archetype*> remove_edges_;
+
+  /// @brief Computes column_offsets_ for a chunk holding capacity rows and
+  /// returns the number of bytes such a chunk needs.
+  size_t layout_chunk(size_t capacity);
+};
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_ARCHETYPE_H_
@@ -0,0 +1,221 @@
+#include "src/ecs/archetype/archetype_storage.h"
+
+#include <absl/log/check.h>
+#include <absl/log/log.h>
+
+#include <memory_resource>
+#include <vector>
+
+#include "src/ecs/archetype/archetype.h"
+#include "src/ecs/context/context.h"
+#include "src/ecs/memory/memory.h"
+
+namespace ecs {
+
+ArchetypeStorage::ArchetypeStorage(std::pmr::memory_resource* resource)
+    : type_infos_(resource),
+      archetypes_by_signature_(resource),
+      archetypes_(resource),
+      records_(resource),
+      record_index_(resource) {
+  root_ = find_or_create_archetype(Signature());
+}
+
+ArchetypeStorage& ArchetypeStorage::RegisterComponentType(
+    ComponentTypeId component_type, const ComponentTypeInfo& type_info) {
+  if (component_type >= type_infos_.size()) {
+    type_infos_.resize(static_cast<size_t>(component_type) + 1);
+  }
+  if (type_infos_[component_type] == nullptr) {
+    type_infos_[component_type] = MakeResourcePtr<ComponentTypeInfo>(
+        type_infos_.get_allocator().resource(), type_info);
+  }
+
+  return *this;
+}
+
+ArchetypeStorage& ArchetypeStorage::RemoveComponent(
+    Entity entity, ComponentTypeId component_type) {
+  if (!HasComponent(entity, component_type)) {
+    LOG(WARNING) << "Removing non-existent component of type '"
+                 << type_name(component_type) << "'.";
+    return *this;
+  }
+
+  EntityRecord* record = find_record(entity);
+  Archetype* target = remove_target(record->archetype, component_type);
+
+  // Entities without components are not stored
+  if (target == root_) {
+    record->archetype->DestroyRow(record->row);
+    erase_entity(entity);
+    return *this;
+  }
+
+  move_entity(entity, target);
+
+  return *this;
+}
+
+bool ArchetypeStorage::HasComponent(Entity entity,
+                                    ComponentTypeId component_type) const {
+  const EntityRecord* record = find_record(entity);
+  return record != nullptr && record->archetype->GetColumn(component_type) >= 0;
+}
+
+ArchetypeStorage& ArchetypeStorage::EntityDestroyed(Entity entity) {
+  EntityRecord* record = find_record(entity);
+  if (record == nullptr) {
+    return *this;
+  }
+
+  record->archetype->DestroyRow(record->row);
+  erase_entity(entity);
+
+  return *this;
+}
+
+Archetype* ArchetypeStorage::GetArchetype(Entity entity) const {
+  const EntityRecord* record = find_record(entity);
+  return record ? record->archetype : nullptr;
+}
+
+// #########################
+// #        PRIVATE        #
+// #########################
+Archetype* ArchetypeStorage::find_or_create_archetype(
+    const Signature& signature) {
+  auto existing = archetypes_by_signature_.find(signature);
+  if (existing != archetypes_by_signature_.end()) {
+    return existing->second.get();
+  }
+
+  // Columns are ordered by component type ID
+  std::pmr::memory_resource* resource = archetypes_.get_allocator().resource();
+  std::pmr::vector<ComponentTypeId> component_types(resource);
+  std::pmr::vector<const ComponentTypeInfo*> type_infos(resource);
+  for (size_t type = 0; type < type_infos_.size(); ++type) {
+    if (signature.test(type)) {
+      CHECK(type_infos_[type] != nullptr)
+          << "Component type " << type
+          << " used in an archetype before it was registered.";
+      component_types.push_back(static_cast<ComponentTypeId>(type));
+      type_infos.push_back(type_infos_[type].get());
+    }
+  }
+
+  auto archetype = MakeResourcePtr<Archetype>(
+      resource, signature, std::move(component_types), std::move(type_infos),
+      resource);
+  Archetype* pointer = archetype.get();
+  archetypes_by_signature_.insert({signature, std::move(archetype)});
+  archetypes_.push_back(pointer);
+
+  return pointer;
+}
+
+Archetype* ArchetypeStorage::add_target(Archetype* source,
+                                        ComponentTypeId component_type) {
+  Archetype* target = source->GetAddEdge(component_type);
+  if (target == nullptr) {
+    Signature signature = source->get_signature();
+    signature.set(component_type, true);
+    target = find_or_create_archetype(signature);
+
+    // Cache the transition in both directions
+    source->SetAddEdge(component_type, target);
+    target->SetRemoveEdge(component_type, source);
+  }
+
+  return target;
+}
+
+Archetype* ArchetypeStorage::remove_target(Archetype* source,
+                                           ComponentTypeId component_type) {
+  Archetype* target = source->GetRemoveEdge(component_type);
+  if (target == nullptr) {
+    Signature signature = source->get_signature();
+    signature.set(component_type, false);
+    target = find_or_create_archetype(signature);
+
+    // Cache the transition in both directions
+    source->SetRemoveEdge(component_type, target);
+    target->SetAddEdge(component_type, source);
+  }
+
+  return target;
+}
+
+size_t ArchetypeStorage::move_entity(Entity entity, Archetype* target) {
+  EntityRecord* record = find_record(entity);
+  Archetype* source = record->archetype;
+  size_t source_row = record->row;
+  size_t target_row = target->AppendRow(entity);
+
+  // Relocate the columns both archetypes share and destroy the rest
+  const std::pmr::vector<ComponentTypeId>& source_types =
+      source->get_component_types();
+  for (size_t column = 0; column < source_types.size(); ++column) {
+    void* value = source->GetComponent(column, source_row);
+    int target_column = target->GetColumn(source_types[column]);
+    if (target_column >= 0) {
+      source->get_type_info(column).relocate(
+          target->GetComponent(static_cast<size_t>(target_column), target_row),
+          value);
+    } else {
+      source->get_type_info(column).destroy(value);
+    }
+  }
+
+  // Fix up the record of the entity that filled the vacated source row
+  Entity moved_entity = source->EraseRow(source_row);
+  if (moved_entity != entity) {
+    find_record(moved_entity)->row = source_row;
+  }
+
+  record->archetype = target;
+  record->row = target_row;
+
+  return target_row;
+}
+
+void ArchetypeStorage::erase_entity(Entity entity) {
+  EntityRecord* record = find_record(entity);
+  Archetype* archetype = record->archetype;
+
+  Entity moved_entity = archetype->EraseRow(record->row);
+  if (moved_entity != entity) {
+    find_record(moved_entity)->row = record->row;
+  }
+
+  // Swap-remove the record to keep records_ packed
+  Entity record_index = record_index_.Get(entity);
+  EntityRecord& last_record = records_.back();
+  if (last_record.entity != entity) {
+    records_[record_index] = last_record;
+    record_index_.Set(last_record.entity, record_index);
+  }
+  records_.pop_back();
+  record_index_.Erase(entity);
+}
+
+ArchetypeStorage::EntityRecord* ArchetypeStorage::find_record(Entity entity) {
+  Entity index = record_index_.Get(entity);
+  return index == SparseIndex::kInvalidIndex ? nullptr : &records_[index];
+}
+
+const ArchetypeStorage::EntityRecord* ArchetypeStorage::find_record(
+    Entity entity) const {
+  Entity index = record_index_.Get(entity);
+  return index == SparseIndex::kInvalidIndex ? nullptr : &records_[index];
+}
+
+const char* ArchetypeStorage::type_name(ComponentTypeId component_type) const {
+  if (component_type < type_infos_.size() &&
+      type_infos_[component_type] != nullptr) {
+    return type_infos_[component_type]->name;
+  }
+  return "unknown";
+}
+
+}  // namespace ecs
@@ -0,0 +1,225 @@
+/**
+ * @file archetype_storage.h
+ * @brief Archetype-based component storage backend.
+ *
+ * @details
+ * Stores components grouped by the full set of component types an entity has,
+ * instead of one ComponentArray per type. Selected per Coordinator with
+ * StorageMode::kArchetypes.
+ */
+
+#ifndef TBGE_ECS_ARCHETYPE_STORAGE_H_
+#define TBGE_ECS_ARCHETYPE_STORAGE_H_
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+
+#include "src/ecs/archetype/archetype.h"
+#include "src/ecs/context/context.h"
+#include "src/ecs/memory/memory.h"
+#include "src/ecs/sparse_index/sparse_index.h"
+
+namespace ecs {
+
+/**
+ * @class ArchetypeStorage
+ * @brief Owns all archetypes and tracks which archetype row holds each entity.
+ *
+ * @details
+ * Every entity with at least one component lives in exactly one Archetype,
+ * the one whose signature equals the entity's signature. Adding or removing a
+ * component moves the entity's row to the neighbouring archetype, found through
+ * the transition edges cached on each archetype.
+ *
+ * Entities without components are not stored.
+ *
+ * @note Component references returned by GetComponent() are invalidated by any
+ * structural change to the entity that owns them or to another entity in the
+ * same archetype.
+ */
+class ArchetypeStorage {
+ public:
+  /**
+   * @brief Constructs the storage with only the empty root archetype.
+   *
+   * @param resource The memory resource archetypes, their chunks and the
+   * entity records are allocated from. Must outlive the storage.
+   */
+  explicit ArchetypeStorage(
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  /**
+   * @brief Registers the type information of a component type.
+   *
+   * @note Registering the same component type ID twice is ignored.
+   *
+   * @param component_type The component type ID.
+   * @param type_info The type information describing the component type.
+   * @return Reference to the current ArchetypeStorage for method chaining.
+   */
+  ArchetypeStorage& RegisterComponentType(ComponentTypeId component_type,
+                                          const ComponentTypeInfo& type_info);
+
+  /**
+   * @brief Adds a component to an entity, moving the entity to the archetype
+   * that also has the component type.
+   *
+   * @tparam T The type of the component.
+   * @param entity The entity the component is added to.
+   * @param component_type The component type ID of T.
+   * @param component The component to add.
+   * @return Reference to the current ArchetypeStorage for method chaining.
+   */
+  template <typename T>
+  ArchetypeStorage& AddComponent(Entity entity, ComponentTypeId component_type,
+                                 T component);
+
+  /**
+   * @brief Constructs a component in place in the column of the archetype the
+   * entity moves to.
+   *
+   * @tparam T The type of the component.
+   * @tparam Args The constructor argument types of T.
+   * @param entity The entity the component is added to.
+   * @param component_type The component type ID of T.
+   * @param args The arguments forwarded to the constructor of T.
+   * @return Reference to the current ArchetypeStorage for method chaining.
+   */
+  template <typename T, typename... Args>
+  ArchetypeStorage& EmplaceComponent(Entity entity,
+                                     ComponentTypeId component_type,
+                                     Args&&... args);
+
+  /**
+   * @brief Removes a component from an entity, moving the entity to the
+   * archetype without the component type.
+   *
+   * @param entity The entity the component is removed from.
+   * @param component_type The component type ID of the component.
+   * @return Reference to the current ArchetypeStorage for method chaining.
+   */
+  ArchetypeStorage& RemoveComponent(Entity entity,
+                                    ComponentTypeId component_type);
+
+  /**
+   * @brief Checks whether an entity has a component of the given type.
+   *
+   * @param entity The entity to check.
+   * @param component_type The component type ID to check for.
+   * @return true if the entity has the component; false otherwise.
+   */
+  bool HasComponent(Entity entity, ComponentTypeId component_type) const;
+
+  /**
+   * @brief Returns the component of an entity.
+   *
+   * @note Will abort if the entity does not have the component.
+   *
+   * @tparam T The type of the component.
+   * @param entity The entity whose component is returned.
+   * @param component_type The component type ID of T.
+   * @return A reference to the component.
+   */
+  template <typename T>
+  T& GetComponent(Entity entity, ComponentTypeId component_type);
+
+  /**
+   * @brief Destroys all components of an entity.
+   *
+   * @param entity The entity that has been destroyed.
+   * @return Reference to the current ArchetypeStorage for method chaining.
+   */
+  ArchetypeStorage& EntityDestroyed(Entity entity);
+
+  /**
+   * @brief Calls func(entity, components...) for every entity that has all of
+   * the given component types.
+   *
+   * @details
+   * Visits every archetype whose signature contains the requested types and
+   * walks its chunks linearly, passing the matching columns directly.
+   *
+   * @note func must not add or remove components or destroy entities.
+   *
+   * @tparam Ts The component types to visit.
+   * @tparam Func Callable taking (Entity, Ts&...).
+   * @param component_types The component type IDs of Ts, in the same order.
+   * @param func The function to call for every matching entity.
+   * @return Reference to the current ArchetypeStorage for method chaining.
+   */
+  template <typename... Ts, typename Func>
+  ArchetypeStorage& Each(
+      const std::array<ComponentTypeId, sizeof...(Ts)>& component_types,
+      Func&& func);
+
+  /**
+   * @brief Returns the archetype holding an entity.
+   *
+   * @param entity The entity to look up.
+   * @return The entity's archetype, or nullptr if it has no components.
+   */
+  Archetype* GetArchetype(Entity entity) const;
+
+  /// @brief Returns every archetype, including the empty root archetype.
+  const std::pmr::vector<Archetype*>& get_archetypes() const {
+    return archetypes_;
+  }
+
+ private:
+  /// @brief Location of an entity's row.
+  struct EntityRecord {
+    Entity entity;
+    Archetype* archetype;
+    size_t row;
+  };
+
+  /// @brief Type information indexed by component type ID.
+  std::pmr::vector<ResourcePtr<ComponentTypeInfo>> type_infos_;
+
+  /// @brief Owning map from signature to archetype.
+  std::pmr::unordered_map<Signature, ResourcePtr<Archetype>>
+      archetypes_by_signature_;
+
+  /// @brief Archetypes in creation order, for iteration.
+  std::pmr::vector<Archetype*> archetypes_;
+
+  /// @brief The archetype without any component types.
+  Archetype* root_ = nullptr;
+
+  /// @brief Packed entity records and their index keyed by entity ID.
+  std::pmr::vector<EntityRecord> records_;
+  SparseIndex record_index_;
+
+  /// @brief Returns the archetype with the signature, creating it if needed.
+  Archetype* find_or_create_archetype(const Signature& signature);
+
+  /// @brief Returns the archetype reached by adding a component type.
+  Archetype* add_target(Archetype* source, ComponentTypeId component_type);
+
+  /// @brief Returns the archetype reached by removing a component type.
+  Archetype* remove_target(Archetype* source, ComponentTypeId component_type);
+
+  /// @brief Moves the entity's row into target, relocating shared columns and
+  /// destroying the others, and returns the new row.
+  size_t move_entity(Entity entity, Archetype* target);
+
+  /// @brief Erases the entity's row and record. Column values must already be
+  /// destroyed.
+  void erase_entity(Entity entity);
+
+  /// @brief Returns the entity's record, or nullptr.
+  EntityRecord* find_record(Entity entity);
+  const EntityRecord* find_record(Entity entity) const;
+
+  /// @brief Returns the name of a component type for log messages.
+  const char* type_name(ComponentTypeId component_type) const;
+};
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_ARCHETYPE_STORAGE_H_
+
+#include "src/ecs/archetype/archetype_storage.tcc"
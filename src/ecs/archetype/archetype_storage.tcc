@@ -0,0 +1,108 @@
+#ifndef TBGE_ECS_ARCHETYPE_STORAGE_TCC_
+#define TBGE_ECS_ARCHETYPE_STORAGE_TCC_
+
+#include <absl/log/check.h>
+#include <absl/log/log.h>
+
+#include <array>
+#include <new>
+#include <tuple>
+#include <utility>
+
+#include "src/ecs/archetype/archetype.h"
+#include "src/ecs/archetype/archetype_storage.h"
+#include "src/ecs/context/context.h"
+
+namespace ecs {
+
+template <typename T>
+ArchetypeStorage& ArchetypeStorage::AddComponent(Entity entity,
+                                                 ComponentTypeId component_type,
+                                                 T component) {
+  return EmplaceComponent<T>(entity, component_type, std::move(component));
+}
+
+template <typename T, typename... Args>
+ArchetypeStorage& ArchetypeStorage::EmplaceComponent(
+    Entity entity, ComponentTypeId component_type, Args&&... args) {
+  if (HasComponent(entity, component_type)) {
+    LOG(WARNING) << "Component of type '" << typeid(T).name()
+                 << "' added to the same entity more than once.";
+    return *this;
+  }
+
+  EntityRecord* record = find_record(entity);
+  Archetype* target =
+      add_target(record ? record->archetype : root_, component_type);
+
+  size_t row;
+  if (record == nullptr) {
+    // First component of the entity - create its record
+    row = target->AppendRow(entity);
+    record_index_.Set(entity, static_cast<Entity>(records_.size()));
+    records_.push_back({entity, target, row});
+  } else {
+    row = move_entity(entity, target);
+  }
+
+  ::new (target->GetComponent(target->GetColumn(component_type), row))
+      T(std::forward<Args>(args)...);
+
+  return *this;
+}
+
+template <typename T>
+T& ArchetypeStorage::GetComponent(Entity entity,
+                                  ComponentTypeId component_type) {
+  EntityRecord* record = find_record(entity);
+  int column = record ? record->archetype->GetColumn(component_type) : -1;
+  CHECK(column >= 0) << "Retrieving non-existent component of type '"
+                     << typeid(T).name() << "'.";
+
+  return *std::launder(static_cast<T*>(
+      record->archetype->GetComponent(static_cast<size_t>(column),
+                                      record->row)));
+}
+
+template <typename... Ts, typename Func>
+ArchetypeStorage& ArchetypeStorage::Each(
+    const std::array<ComponentTypeId, sizeof...(Ts)>& component_types,
+    Func&& func) {
+  Signature required;
+  for (ComponentTypeId component_type : component_types) {
+    required.set(component_type, true);
+  }
+
+  for (Archetype* archetype : archetypes_) {
+    if (archetype->get_size() == 0 ||
+        !archetype->get_signature().includes(required)) {
+      continue;
+    }
+
+    // Resolve the columns once per archetype, then walk each chunk linearly
+    std::array<size_t, sizeof...(Ts)> columns;
+    for (size_t i = 0; i < sizeof...(Ts); ++i) {
+      columns[i] =
+          static_cast<size_t>(archetype->GetColumn(component_types[i]));
+    }
+
+    for (size_t chunk = 0; chunk < archetype->get_chunk_count(); ++chunk) {
+      Entity* entities = archetype->GetChunkEntities(chunk);
+      size_t chunk_size = archetype->GetChunkSize(chunk);
+
+      [&]<size_t... Is>(std::index_sequence<Is...>) {
+        std::tuple<Ts*...> column_data{std::launder(reinterpret_cast<Ts*>(
+            archetype->GetChunkColumn(chunk, columns[Is])))...};
+        for (size_t row = 0; row < chunk_size; ++row) {
+          func(entities[row], std::get<Is>(column_data)[row]...);
+        }
+      }(std::index_sequence_for<Ts...>{});
+    }
+  }
+
+  return *this;
+}
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_ARCHETYPE_STORAGE_TCC_
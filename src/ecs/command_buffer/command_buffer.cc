@@ -0,0 +1,144 @@
+#include "src/ecs/command_buffer/command_buffer.h"
+
+#include <absl/log/check.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "src/ecs/context/context.h"
+#include "src/ecs/coordinator/coordinator.h"
+
+namespace ecs {
+
+CommandBuffer::CommandBuffer(std::pmr::memory_resource* resource)
+    : commands_(resource), arena_(resource) {}
+
+CommandBuffer::~CommandBuffer() { Clear(); }
+
+CommandBuffer::PendingEntity CommandBuffer::CreateEntity() {
+  CHECK(pending_count_ < kMaxEntities)
+      << "Too many Entities were created in one CommandBuffer. The maximum "
+         "amount of Entities is "
+      << kMaxEntities << ".";
+
+  commands_.push_back({CommandType::kCreateEntity, PendingEntity{0}});
+  return PendingEntity{pending_count_++};
+}
+
+CommandBuffer& CommandBuffer::DestroyEntity(Target target) {
+  commands_.push_back({CommandType::kDestroyEntity, target});
+
+  return *this;
+}
+
+std::pmr::vector<Entity> CommandBuffer::Flush(Coordinator& coordinator) {
+  std::pmr::memory_resource* resource = commands_.get_allocator().resource();
+
+  // Create every pending entity at once, then resolve the placeholders
+  std::pmr::vector<Entity> created(pending_count_, resource);
+  coordinator.CreateEntities(created);
+  auto resolve = [&created](const Target& target) {
+    return target.pending_ ? created[target.entity_] : target.entity_;
+  };
+
+  std::pmr::vector<Entity> destroyed(resource);
+  std::pmr::vector<const Command*> component_commands(resource);
+  for (const Command& command : commands_) {
+    if (command.type == CommandType::kDestroyEntity) {
+      destroyed.push_back(resolve(command.target));
+    } else if (command.type != CommandType::kCreateEntity) {
+      component_commands.push_back(&command);
+    }
+  }
+  std::sort(destroyed.begin(), destroyed.end());
+  destroyed.erase(std::unique(destroyed.begin(), destroyed.end()),
+                  destroyed.end());
+
+  // Group the component commands by type, then by entity in recording order
+  std::stable_sort(component_commands.begin(), component_commands.end(),
+                   [&resolve](const Command* a, const Command* b) {
+                     if (a->ops->type_index != b->ops->type_index) {
+                       return a->ops->type_index < b->ops->type_index;
+                     }
+                     return resolve(a->target) < resolve(b->target);
+                   });
+
+  std::pmr::vector<Entity> added(resource);
+  std::pmr::vector<void*> payloads(resource);
+  std::pmr::vector<Entity> removed(resource);
+  for (size_t begin = 0; begin < component_commands.size();) {
+    const Command& first = *component_commands[begin];
+    Entity entity = resolve(first.target);
+
+    // Find the commands for the same entity and component type
+    bool adds = false;
+    bool removes = false;
+    size_t end = begin;
+    for (; end < component_commands.size() &&
+           component_commands[end]->ops == first.ops &&
+           resolve(component_commands[end]->target) == entity;
+         ++end) {
+      adds |= component_commands[end]->type == CommandType::kAddComponent;
+      removes |= component_commands[end]->type == CommandType::kRemoveComponent;
+    }
+    const Command& last = *component_commands[end - 1];
+    begin = end;
+
+    // Apply their net effect, unless the entity is destroyed anyway
+    if (!std::binary_search(destroyed.begin(), destroyed.end(), entity)) {
+      if (last.type == CommandType::kAddComponent) {
+        // A removal before the addition makes it replace the component
+        if (removes && last.ops->has(coordinator, entity)) {
+          removed.push_back(entity);
+        }
+        added.push_back(entity);
+        payloads.push_back(last.payload);
+      } else if (!adds || last.ops->has(coordinator, entity)) {
+        // An addition before the removal cancels it out if the entity did not
+        // have the component
+        removed.push_back(entity);
+      }
+    }
+
+    // Apply the batches at the end of each component type. Removals go first
+    // so that replaced components can be added again.
+    if (begin == component_commands.size() ||
+        component_commands[begin]->ops != last.ops) {
+      if (!removed.empty()) {
+        last.ops->remove(coordinator, removed);
+      }
+      if (!added.empty()) {
+        last.ops->add(coordinator, added, payloads);
+      }
+      added.clear();
+      payloads.clear();
+      removed.clear();
+    }
+  }
+
+  for (Entity entity : destroyed) {
+    coordinator.DestroyEntity(entity);
+  }
+
+  Clear();
+
+  return created;
+}
+
+CommandBuffer& CommandBuffer::Clear() {
+  for (const Command& command : commands_) {
+    if (command.type == CommandType::kAddComponent) {
+      command.ops->destroy(command.payload);
+    }
+  }
+
+  commands_.clear();
+  arena_.release();
+  pending_count_ = 0;
+
+  return *this;
+}
+
+}  // namespace ecs
@@ -0,0 +1,303 @@
+/**
+ * @file command_buffer.h
+ * @brief Records structural changes to apply them later at a sync point.
+ *
+ * @details
+ * Creating and destroying entities or adding and removing components changes
+ * the entity sets of systems and the packed component arrays. Doing so while
+ * iterating them invalidates the iterators. A CommandBuffer records these
+ * changes instead, and Flush() applies them once the iteration is over.
+ */
+
+#ifndef TBGE_ECS_COMMAND_BUFFER_H_
+#define TBGE_ECS_COMMAND_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+#include "src/ecs/context/context.h"
+#include "src/ecs/coordinator/coordinator.h"
+
+namespace ecs {
+
+/**
+ * @class CommandBuffer
+ * @brief Linear log of deferred entity and component changes.
+ *
+ * @details
+ * Commands are appended to a vector, and component payloads are moved into an
+ * arena that is released as a whole, so recording never frees memory and
+ * never moves a payload.
+ *
+ * Flush() applies the commands in batches instead of in recording order:
+ * - All created entities are created at once.
+ * - Component commands are sorted by component type. Additions of one type
+ *   are added together and the systems are notified once for them.
+ * - Destroyed entities are destroyed last.
+ *
+ * Commands for the same entity and component type are coalesced into their
+ * net effect: the last addition is applied, replacing the entity's component
+ * if a removal was recorded before it, and an addition followed by a removal
+ * leaves the entity as it was if it did not have the component. Component
+ * commands for entities that the buffer also destroys are dropped.
+ *
+ * Example:
+ * @code
+ *   ecs::CommandBuffer commands;
+ *   for (ecs::Entity entity : system->get_entities()) {
+ *     if (coordinator.GetComponent<Health>(entity).points <= 0) {
+ *       commands.DestroyEntity(entity);
+ *       auto corpse = commands.CreateEntity();
+ *       commands.AddComponent(corpse, Corpse{entity});
+ *     }
+ *   }
+ *   commands.Flush(coordinator);
+ * @endcode
+ *
+ * @note Recording does not check whether entities or components exist. Flush()
+ * reports problems the same way the Coordinator methods it calls do.
+ */
+class CommandBuffer {
+ public:
+  /**
+   * @brief An entity created by the buffer, which gets its ID on Flush().
+   */
+  struct PendingEntity {
+    /// Position of the entity in the vector returned by Flush()
+    size_t index;
+  };
+
+  /**
+   * @brief The entity a command applies to, either an existing or a pending
+   * one.
+   */
+  class Target {
+   public:
+    /// @brief Targets an existing entity.
+    Target(Entity entity) : entity_(entity), pending_(false) {}
+
+    /// @brief Targets an entity created by the same buffer.
+    Target(PendingEntity entity)
+        : entity_(static_cast<Entity>(entity.index)), pending_(true) {}
+
+   private:
+    friend class CommandBuffer;
+
+    Entity entity_;
+    bool pending_;
+  };
+
+  /**
+   * @brief Constructs an empty buffer.
+   *
+   * @param resource The memory resource for the commands and payloads. Must
+   * outlive the buffer.
+   */
+  explicit CommandBuffer(
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  CommandBuffer(const CommandBuffer&) = delete;
+  CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+  /// @brief Destroys the payloads of commands that were never flushed.
+  ~CommandBuffer();
+
+  /**
+   * @brief Records the creation of an entity.
+   *
+   * @return A placeholder that later commands of this buffer can target.
+   */
+  PendingEntity CreateEntity();
+
+  /**
+   * @brief Records the destruction of an entity.
+   *
+   * @param target The entity to destroy.
+   * @return Reference to this buffer for method chaining.
+   */
+  CommandBuffer& DestroyEntity(Target target);
+
+  /**
+   * @brief Records adding a component to an entity.
+   *
+   * @tparam T The component type. Must be registered by the time of Flush().
+   * @param target The entity to add the component to.
+   * @param component The component, moved into the buffer.
+   * @return Reference to this buffer for method chaining.
+   */
+  template <typename T>
+  CommandBuffer& AddComponent(Target target, T component);
+
+  /**
+   * @brief Records adding a component constructed from args.
+   *
+   * @details
+   * The component is constructed in the buffer right away and moved into its
+   * pool on Flush().
+   *
+   * @tparam T The component type. Must be registered by the time of Flush().
+   * @param target The entity to add the component to.
+   * @param args The arguments to construct the component from.
+   * @return Reference to this buffer for method chaining.
+   */
+  template <typename T, typename... Args>
+  CommandBuffer& EmplaceComponent(Target target, Args&&... args);
+
+  /**
+   * @brief Records removing a component from an entity.
+   *
+   * @tparam T The component type.
+   * @param target The entity to remove the component from.
+   * @return Reference to this buffer for method chaining.
+   */
+  template <typename T>
+  CommandBuffer& RemoveComponent(Target target);
+
+  /**
+   * @brief Applies every recorded command and empties the buffer.
+   *
+   * @param coordinator The Coordinator to apply the commands to. Must not be
+   * iterating any of its entities or pools.
+   * @return The entities created for the buffer's PendingEntity placeholders,
+   * indexed by PendingEntity::index, allocated from the buffer's memory
+   * resource.
+   */
+  std::pmr::vector<Entity> Flush(Coordinator& coordinator);
+
+  /**
+   * @brief Drops every recorded command without applying it.
+   *
+   * @return Reference to this buffer for method chaining.
+   */
+  CommandBuffer& Clear();
+
+  /// @brief Returns the number of recorded commands.
+  size_t get_size() const { return commands_.size(); }
+
+ private:
+  enum class CommandType : std::uint8_t {
+    kCreateEntity,
+    kDestroyEntity,
+    kAddComponent,
+    kRemoveComponent,
+  };
+
+  /// @brief Type-erased operations on the components of one type.
+  struct ComponentOps {
+    /// Sort key of the component type
+    size_t type_index;
+
+    /// Moves payloads into the components of entities
+    void (*add)(Coordinator& coordinator, std::span<const Entity> entities,
+                std::span<void* const> payloads);
+
+    /// Removes the component from entities
+    void (*remove)(Coordinator& coordinator, std::span<const Entity> entities);
+
+    /// Checks whether an entity has the component
+    bool (*has)(Coordinator& coordinator, Entity entity);
+
+    /// Destroys a payload
+    void (*destroy)(void* payload);
+  };
+
+  struct Command {
+    CommandType type;
+    Target target;
+
+    /// Component type of component commands, nullptr otherwise
+    const ComponentOps* ops = nullptr;
+
+    /// Component to add, in arena_
+    void* payload = nullptr;
+  };
+
+  std::pmr::vector<Command> commands_;
+
+  /// Holds the payloads of kAddComponent commands
+  std::pmr::monotonic_buffer_resource arena_;
+
+  /// Number of PendingEntity placeholders handed out
+  size_t pending_count_ = 0;
+
+  /// @brief Returns the operations for component type T.
+  template <typename T>
+  static const ComponentOps* ops();
+
+  template <typename T>
+  static void add_components(Coordinator& coordinator,
+                             std::span<const Entity> entities,
+                             std::span<void* const> payloads);
+
+  template <typename T>
+  static void remove_components(Coordinator& coordinator,
+                                std::span<const Entity> entities);
+};
+
+/// @brief Entities per task of ParallelEach() unless a grain size is given.
+inline constexpr size_t kDefaultParallelGrainSize = 1024;
+
+/**
+ * @brief Calls func for every entity of a Coordinator that has all of the
+ * component types Ts, on all threads of a JobSystem.
+ *
+ * @details
+ * The array driving the View<Ts...> is split into chunks of grain_size
+ * entities, which run as tasks of job_system. The calling thread takes part
+ * and returns once every chunk has finished.
+ *
+ * No structural change may happen during the call: creating or destroying
+ * entities, adding or removing components, or sorting and shrinking pools
+ * aborts. Instead, func may take a CommandBuffer& as its first argument and
+ * record the changes there. Each chunk records into its own buffer, allocated
+ * from the Coordinator's memory resource, and the buffers are flushed in chunk
+ * order after every chunk has finished, so the outcome does not depend on
+ * which thread ran which chunk.
+ *
+ * @code
+ *   ecs::ParallelEach<Npc, Position>(
+ *       coordinator, job_system,
+ *       [](ecs::CommandBuffer& commands, ecs::Entity entity, Npc& npc,
+ *          const Position& position) {
+ *         npc.Think(position);
+ *         if (npc.hunger <= 0) {
+ *           commands.DestroyEntity(entity);
+ *         }
+ *       });
+ * @endcode
+ *
+ * @note func is called from several threads at once. It may modify the
+ * components it is given, but must only read other components. Only
+ * available with StorageMode::kComponentArrays.
+ *
+ * @tparam Ts The distinct component types to visit.
+ * @tparam Func Callable taking (Entity, ComponentReference<Ts>...), or
+ * (CommandBuffer&, Entity, ComponentReference<Ts>...).
+ * @param coordinator The Coordinator whose entities are visited.
+ * @param job_system The JobSystem to run the chunks on.
+ * @param func The function to call for every matching entity.
+ * @param grain_size The number of entities per chunk. Must be greater than
+ * 0.
+ * @return Reference to the Coordinator for method chaining.
+ */
+template <typename... Ts, typename Func>
+Coordinator& ParallelEach(Coordinator& coordinator,
+                          tbge::jobs::JobSystem& job_system, Func&& func,
+                          size_t grain_size);
+
+/**
+ * @brief Calls ParallelEach() with kDefaultParallelGrainSize entities per
+ * chunk.
+ */
+template <typename... Ts, typename Func>
+Coordinator& ParallelEach(Coordinator& coordinator,
+                          tbge::jobs::JobSystem& job_system, Func&& func);
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_COMMAND_BUFFER_H_
+
+#include "src/ecs/command_buffer/command_buffer.tcc"
@@ -0,0 +1,141 @@
+#ifndef TBGE_ECS_COMMAND_BUFFER_TCC_
+#define TBGE_ECS_COMMAND_BUFFER_TCC_
+
+#include <absl/cleanup/cleanup.h>
+#include <absl/log/check.h>
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "src/ecs/command_buffer/command_buffer.h"
+#include "src/ecs/component/soa.h"
+#include "src/ecs/context/context.h"
+#include "src/ecs/coordinator/coordinator.h"
+#include "src/ecs/type_index/type_index.h"
+#include "src/jobs/job_system.h"
+
+namespace ecs {
+
+template <typename T>
+CommandBuffer& CommandBuffer::AddComponent(Target target, T component) {
+  return EmplaceComponent<T>(target, std::move(component));
+}
+
+template <typename T, typename... Args>
+CommandBuffer& CommandBuffer::EmplaceComponent(Target target,
+                                               Args&&... args) {
+  T* payload = std::pmr::polymorphic_allocator<T>(&arena_).allocate(1);
+  std::construct_at(payload, std::forward<Args>(args)...);
+  commands_.push_back(
+      {CommandType::kAddComponent, target, ops<T>(), payload});
+
+  return *this;
+}
+
+template <typename T>
+CommandBuffer& CommandBuffer::RemoveComponent(Target target) {
+  commands_.push_back({CommandType::kRemoveComponent, target, ops<T>()});
+
+  return *this;
+}
+
+// #####   ParallelEach   #####
+template <typename... Ts, typename Func>
+Coordinator& ParallelEach(Coordinator& coordinator,
+                          tbge::jobs::JobSystem& job_system, Func&& func,
+                          size_t grain_size) {
+  CHECK(grain_size > 0) << "ParallelEach needs a grain size of at least 1.";
+  coordinator.check_structural_change("start a nested ParallelEach");
+
+  ecs::View<Ts...> view = coordinator.template View<Ts...>();
+  size_t size = view.get_size_hint();
+  size_t chunk_count = (size + grain_size - 1) / grain_size;
+
+  // A deque constructs the buffers in place, as they cannot be moved
+  std::pmr::memory_resource* resource = coordinator.get_memory_resource();
+  std::pmr::deque<CommandBuffer> buffers(resource);
+  for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+    buffers.emplace_back(resource);
+  }
+
+  {
+    coordinator.in_parallel_each_ = true;
+    absl::Cleanup end_parallel_each = [&coordinator] {
+      coordinator.in_parallel_each_ = false;
+    };
+
+    tbge::jobs::ParallelFor(
+        job_system, 0, size, grain_size, [&](size_t begin, size_t end) {
+          CommandBuffer& commands = buffers[begin / grain_size];
+          view.each(begin, end,
+                    [&](Entity entity, ComponentReference<Ts>... components) {
+                      if constexpr (std::is_invocable_v<
+                                        Func&, CommandBuffer&, Entity,
+                                        ComponentReference<Ts>...>) {
+                        func(commands, entity, components...);
+                      } else {
+                        func(entity, components...);
+                      }
+                    });
+        });
+  }
+
+  for (CommandBuffer& commands : buffers) {
+    if (commands.get_size() > 0) {
+      commands.Flush(coordinator);
+    }
+  }
+
+  return coordinator;
+}
+
+template <typename... Ts, typename Func>
+Coordinator& ParallelEach(Coordinator& coordinator,
+                          tbge::jobs::JobSystem& job_system, Func&& func) {
+  return ParallelEach<Ts...>(coordinator, job_system, std::forward<Func>(func),
+                             kDefaultParallelGrainSize);
+}
+
+// #########################
+// #        PRIVATE        #
+// #########################
+template <typename T>
+const CommandBuffer::ComponentOps* CommandBuffer::ops() {
+  static const ComponentOps component_ops{
+      TypeIndex<CommandBuffer>::Get<T>(), &add_components<T>,
+      &remove_components<T>,
+      [](Coordinator& coordinator, Entity entity) {
+        return coordinator.template HasComponent<T>(entity);
+      },
+      [](void* payload) { std::destroy_at(static_cast<T*>(payload)); }};
+  return &component_ops;
+}
+
+template <typename T>
+void CommandBuffer::add_components(Coordinator& coordinator,
+                                   std::span<const Entity> entities,
+                                   std::span<void* const> payloads) {
+  for (size_t i = 0; i < entities.size(); ++i) {
+    coordinator.component_manager_->template EmplaceComponent<T>(
+        entities[i], std::move(*static_cast<T*>(payloads[i])));
+  }
+
+  // Update the signatures and notify the systems once for the whole batch
+  coordinator.template components_added<T>(entities);
+}
+
+template <typename T>
+void CommandBuffer::remove_components(Coordinator& coordinator,
+                                      std::span<const Entity> entities) {
+  // Update the signatures and notify the systems once for the whole batch
+  coordinator.template components_removed<T>(entities);
+}
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_COMMAND_BUFFER_TCC_
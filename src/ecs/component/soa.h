@@ -0,0 +1,241 @@
+/**
+ * @file soa.h
+ * @brief Opt-in structure-of-arrays layout for components.
+ *
+ * @details
+ * Components that specialize SoaTraits are stored with each field in its own
+ * contiguous array instead of as an array of structs. Such components are
+ * accessed through SoaReference, a proxy that refers to one entity's fields.
+ *
+ * Example:
+ * @code
+ *   struct Velocity {
+ *     float dx;
+ *     float dy;
+ *   };
+ *
+ *   template <>
+ *   struct ecs::SoaTraits<Velocity> {
+ *     static constexpr auto kFields = std::make_tuple(&Velocity::dx,
+ *                                                     &Velocity::dy);
+ *   };
+ *
+ *   auto velocity = coordinator.GetComponent<Velocity>(entity);
+ *   velocity.get<&Velocity::dx>() += 1.0f;
+ * @endcode
+ */
+
+#ifndef TBGE_ECS_COMPONENT_SOA_H_
+#define TBGE_ECS_COMPONENT_SOA_H_
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "src/ecs/component/tag.h"
+
+namespace ecs {
+
+/**
+ * @brief Describes the fields of a component stored as a structure of arrays.
+ *
+ * @details
+ * The primary template is empty, which keeps components in the default array
+ * of structs layout. To opt in, specialize it with a `kFields` tuple holding a
+ * pointer to every data member of the component. Members left out of kFields
+ * are not stored.
+ *
+ * @tparam T The component type.
+ */
+template <typename T>
+struct SoaTraits {};
+
+/**
+ * @brief Satisfied by component types that opted into the SoA layout.
+ */
+template <typename T>
+concept SoaComponent =
+    requires { std::tuple_size<decltype(SoaTraits<T>::kFields)>::value; } &&
+    std::is_default_constructible_v<T>;
+
+namespace soa_internal {
+
+/// @brief Extracts the field type from a pointer to data member.
+template <typename MemberPointer>
+struct FieldOf;
+
+template <typename T, typename Field>
+struct FieldOf<Field T::*> {
+  using type = Field;
+};
+
+/// @brief The type of the I-th field listed in SoaTraits<T>::kFields.
+template <typename T, size_t I>
+using FieldType = typename FieldOf<std::remove_cvref_t<std::tuple_element_t<
+    I, std::remove_cvref_t<decltype(SoaTraits<T>::kFields)>>>>::type;
+
+/// @brief The number of fields listed in SoaTraits<T>::kFields.
+template <typename T>
+constexpr size_t kFieldCount =
+    std::tuple_size_v<std::remove_cvref_t<decltype(SoaTraits<T>::kFields)>>;
+
+/// @brief Returns the position of Member in SoaTraits<T>::kFields.
+template <typename T, auto Member, size_t... Is>
+consteval size_t FieldIndex(std::index_sequence<Is...>) {
+  size_t index = sizeof...(Is);
+  (
+      [&] {
+        constexpr auto field = std::get<Is>(SoaTraits<T>::kFields);
+        if constexpr (std::is_same_v<std::remove_cv_t<decltype(field)>,
+                                     decltype(Member)>) {
+          if (field == Member) {
+            index = Is;
+          }
+        }
+      }(),
+      ...);
+  return index;
+}
+
+/// @brief Applies Wrapper to every field type of T and collects the results
+/// in a tuple.
+template <typename T, template <typename> typename Wrapper,
+          typename Sequence = std::make_index_sequence<kFieldCount<T>>>
+struct MapFields;
+
+template <typename T, template <typename> typename Wrapper, size_t... Is>
+struct MapFields<T, Wrapper, std::index_sequence<Is...>> {
+  using type = std::tuple<Wrapper<FieldType<T, Is>>...>;
+};
+
+template <typename Field>
+using AddPointer = Field*;
+
+}  // namespace soa_internal
+
+/**
+ * @brief Proxy reference to one component stored as a structure of arrays.
+ *
+ * @details
+ * Holds a pointer to each of the component's fields. Fields are accessed with
+ * get<&T::member>() or get<I>(). The proxy converts to a T by gathering all
+ * fields, and assigning a T scatters the fields back.
+ *
+ * @note Like a T&, a SoaReference is invalidated when the component is removed
+ * or the storage reallocates.
+ *
+ * @tparam T The component type.
+ */
+template <SoaComponent T>
+class SoaReference {
+ public:
+  /// @brief Tuple holding a pointer to each field.
+  using FieldPointers =
+      typename soa_internal::MapFields<T, soa_internal::AddPointer>::type;
+
+  /**
+   * @brief Constructs a reference from pointers to each field.
+   *
+   * @param fields Pointers to the fields, in SoaTraits<T>::kFields order.
+   */
+  explicit SoaReference(FieldPointers fields) : fields_(fields) {}
+
+  /**
+   * @brief Constructs a reference to the fields of a whole T object.
+   *
+   * @param object The object to refer to.
+   */
+  explicit SoaReference(T& object)
+      : fields_(object_fields(
+            object,
+            std::make_index_sequence<soa_internal::kFieldCount<T>>{})) {}
+
+  /// @brief Returns the field at position I of SoaTraits<T>::kFields.
+  template <size_t I>
+  soa_internal::FieldType<T, I>& get() const {
+    return *std::get<I>(fields_);
+  }
+
+  /// @brief Returns the field identified by a pointer to data member.
+  template <auto Member>
+    requires std::is_member_object_pointer_v<decltype(Member)>
+  auto& get() const {
+    constexpr size_t index = soa_internal::FieldIndex<T, Member>(
+        std::make_index_sequence<soa_internal::kFieldCount<T>>{});
+    static_assert(index < soa_internal::kFieldCount<T>,
+                  "Member is not listed in SoaTraits<T>::kFields.");
+    return get<index>();
+  }
+
+  /// @brief Gathers the fields into a T.
+  operator T() const {
+    T value{};
+    [&]<size_t... Is>(std::index_sequence<Is...>) {
+      ((value.*std::get<Is>(SoaTraits<T>::kFields) = get<Is>()), ...);
+    }(std::make_index_sequence<soa_internal::kFieldCount<T>>{});
+    return value;
+  }
+
+  /// @brief Scatters the fields of value into the referenced component.
+  const SoaReference& operator=(const T& value) const {
+    [&]<size_t... Is>(std::index_sequence<Is...>) {
+      ((get<Is>() = value.*std::get<Is>(SoaTraits<T>::kFields)), ...);
+    }(std::make_index_sequence<soa_internal::kFieldCount<T>>{});
+    return *this;
+  }
+
+ private:
+  FieldPointers fields_;
+
+  template <size_t... Is>
+  static FieldPointers object_fields(T& object, std::index_sequence<Is...>) {
+    return FieldPointers{&(object.*std::get<Is>(SoaTraits<T>::kFields))...};
+  }
+};
+
+/**
+ * @brief The type handed out when accessing a component of type T.
+ *
+ * @details
+ * T& for ordinary components, SoaReference<T> for components that opted into
+ * the structure of arrays layout, and a T by value for tags, which have no
+ * storage to refer to.
+ */
+template <typename T>
+struct ComponentReferenceOf {
+  using type = T&;
+};
+
+template <SoaComponent T>
+struct ComponentReferenceOf<T> {
+  using type = SoaReference<T>;
+};
+
+template <TagComponent T>
+struct ComponentReferenceOf<T> {
+  using type = T;
+};
+
+template <typename T>
+using ComponentReference = typename ComponentReferenceOf<T>::type;
+
+/**
+ * @brief Wraps a whole component object in its ComponentReference type.
+ *
+ * @tparam T The component type.
+ * @param object The component object.
+ * @return object itself, or a SoaReference to its fields.
+ */
+template <typename T>
+ComponentReference<T> MakeComponentReference(T& object) {
+  if constexpr (SoaComponent<T>) {
+    return SoaReference<T>(object);
+  } else {
+    return object;
+  }
+}
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_COMPONENT_SOA_H_
@@ -0,0 +1,95 @@
+/**
+ * @file tag.h
+ * @brief Zero-storage marker components.
+ *
+ * @details
+ * Component types without data members, such as `struct Visible {};`, are
+ * tags. They are never stored: an entity has a tag exactly when the tag's bit
+ * is set in the entity's Signature. Adding or removing a tag only updates the
+ * signature and the systems matching it.
+ *
+ * Example:
+ * @code
+ *   struct Visible {};
+ *
+ *   coordinator.RegisterComponentType<Visible>();
+ *   coordinator.AddComponent(entity, Visible{});
+ *   for (auto [entity, position, visible] :
+ *        coordinator.View<Position, Visible>()) {
+ *     Draw(position);
+ *   }
+ * @endcode
+ */
+
+#ifndef TBGE_ECS_COMPONENT_TAG_H_
+#define TBGE_ECS_COMPONENT_TAG_H_
+
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "src/ecs/context/context.h"
+
+namespace ecs {
+
+/**
+ * @brief Satisfied by empty component types, which are stored as signature
+ * bits only.
+ */
+template <typename T>
+concept TagComponent =
+    std::is_empty_v<T> && std::is_default_constructible_v<T>;
+
+/**
+ * @brief Matches the entities that have tag T, by testing their signatures.
+ *
+ * @details
+ * Offers the HasData()/GetData() interface of a ComponentArray so that views
+ * can filter by tags. GetData() returns a default constructed T, as tags
+ * carry no state.
+ *
+ * @tparam T The tag type.
+ */
+template <TagComponent T>
+class TagFilter {
+ public:
+  /**
+   * @brief Constructs a filter over the signatures of all entities.
+   *
+   * @param signatures The signature of each entity, indexed by entity ID. Must
+   * outlive the filter.
+   * @param component_type The component type ID of T.
+   */
+  TagFilter(const std::pmr::vector<Signature>& signatures,
+            ComponentTypeId component_type)
+      : signatures_(&signatures), component_type_(component_type) {}
+
+  /// @brief Checks whether the entity has tag T.
+  bool HasData(Entity entity) const {
+    return entity < signatures_->size() &&
+           (*signatures_)[entity].test(component_type_);
+  }
+
+  /// @brief Returns a T, as tags carry no data.
+  T GetData(Entity) const { return T{}; }
+
+ private:
+  const std::pmr::vector<Signature>* signatures_;
+  ComponentTypeId component_type_;
+};
+
+namespace tag_internal {
+
+/// @brief std::tuple of the types in Ts that are not tags, in order.
+template <typename... Ts>
+using WithoutTags = decltype(std::tuple_cat(
+    std::declval<std::conditional_t<TagComponent<Ts>, std::tuple<>,
+                                    std::tuple<Ts>>>()...));
+
+}  // namespace tag_internal
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_COMPONENT_TAG_H_
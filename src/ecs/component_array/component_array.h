@@ -4,21 +4,41 @@
  *
  * @details
  * Provides generic and template-based containers for efficiently storing and
- * managing components associated with entities. Uses a packed array layout for
- * cache efficiency.
+ * managing components associated with entities. Uses a sparse-set layout: a
+ * packed array of components for cache efficiency, a parallel dense array of
+ * entity IDs, and a paged SparseIndex keyed by entity ID for O(1) lookups.
+ * Components that specialize SoaTraits are packed as a structure of arrays.
  */
 
 #ifndef TBGE_ECS_COMPONENT_ARRAY_H_
 #define TBGE_ECS_COMPONENT_ARRAY_H_
 
-#include <optional>
-#include <unordered_map>
+#include <cstddef>
+#include <memory_resource>
 #include <vector>
 
+#include "src/ecs/component/soa.h"
+#include "src/ecs/component_array/component_storage.h"
 #include "src/ecs/context/context.h"
+#include "src/ecs/sparse_index/sparse_index.h"
 
 namespace ecs {
 
+/**
+ * @brief Decides when a ComponentArray releases unused capacity on its own.
+ *
+ * @details
+ * After a removal, the array shrinks its storage to fit if its capacity is
+ * larger than min_capacity and less than min_load_factor of it is in use. The
+ * default policy never shrinks automatically.
+ */
+struct ShrinkPolicy {
+  /// Fraction of the capacity below which the array shrinks, in [0, 1].
+  float min_load_factor = 0.0f;
+  /// Arrays with at most this capacity never shrink automatically.
+  size_t min_capacity = 0;
+};
+
 /**
  * @brief Abstract base class for component arrays in an ECS.
  *
@@ -44,6 +64,62 @@ class GenericComponentArray {
    * @return Reference to the current GenericComponentArray for method chaining.
    */
   virtual GenericComponentArray& EntityDestroyed(Entity entity) = 0;
+
+  /**
+   * @brief Releases the memory the array holds beyond its current components.
+   *
+   * @return Reference to the current GenericComponentArray for method chaining.
+   */
+  virtual GenericComponentArray& ShrinkToFit() = 0;
+
+  /**
+   * @brief Sets when the array releases unused capacity on its own.
+   *
+   * @param policy The policy checked after every removal.
+   * @return Reference to the current GenericComponentArray for method chaining.
+   */
+  virtual GenericComponentArray& set_shrink_policy(ShrinkPolicy policy) = 0;
+};
+
+/**
+ * @brief Selects the algorithm used to sort a ComponentArray.
+ */
+enum class SortStrategy {
+  /// Compute the sorted order with std::sort and apply it as a permutation.
+  /// Best for arrays in arbitrary order.
+  kFull,
+  /// Insertion sort with adjacent swaps. Linear for arrays that are already
+  /// almost sorted, e.g. when re-sorting every frame.
+  kInsertion,
+};
+
+/**
+ * @brief Interface of an owning group, notified by the component arrays it
+ * owns.
+ *
+ * @details
+ * An owning group keeps the entities that have all of its component types
+ * packed at the front of each owned ComponentArray. The arrays call these
+ * hooks so the group can reorder entries as components come and go. See
+ * Group.
+ */
+class GenericGroup {
+ public:
+  virtual ~GenericGroup() = default;
+
+  /**
+   * @brief Called after a component was inserted into an owned array.
+   *
+   * @param entity The entity that received the component.
+   */
+  virtual void ComponentAdded(Entity entity) = 0;
+
+  /**
+   * @brief Called before a component is removed from an owned array.
+   *
+   * @param entity The entity whose component is about to be removed.
+   */
+  virtual void ComponentRemoving(Entity entity) = 0;
 };
 
 /**
@@ -51,8 +127,18 @@ class GenericComponentArray {
  *
  * @details
  * This class provides efficient insertion, removal, and retrieval of components
- * associated with entities. It maintains a packed array of components and maps
- * between entities and their corresponding indices in the array.
+ * associated with entities. It is implemented as a sparse set:
+ * - components_ holds the components packed at indices [0, size_).
+ * - dense_entities_ holds the entity owning the component at the same index.
+ * - sparse_ maps an entity ID to the packed index of that entity's
+ * component. It is paged, so only the ranges of entity IDs that hold
+ * components of this type use memory.
+ *
+ * Lookups are a single array read, and removal swaps the last element into the
+ * removed slot so the packed arrays stay dense.
+ *
+ * If T specializes SoaTraits, each listed field is packed into its own array
+ * and components are handed out as SoaReference proxies instead of T&.
  *
  * @tparam T The type of component stored in the array.
  *
@@ -62,28 +148,66 @@ class GenericComponentArray {
 template <typename T>
 class ComponentArray : public GenericComponentArray {
  public:
+  /// @brief The type handed out when accessing a component, T& or a
+  /// SoaReference<T>.
+  using reference = typename ComponentStorage<T>::reference;
+
   /**
-   * @brief Inserts a component into the component_array_.
+   * @brief Constructs an empty ComponentArray.
+   *
+   * @param resource The memory resource the packed arrays and the sparse index
+   * are allocated from. Must outlive the array.
+   */
+  explicit ComponentArray(
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : components_(resource), dense_entities_(resource), sparse_(resource) {}
+
+  /**
+   * @brief Inserts a component into the components_.
    *
    * @details
-   * Adds the given component to the component_array_, associating the entity
-   * with its index in the entity_to_index_map_ and index_to_entity_map_.
+   * Adds the given component to the end of the components_ and records
+   * its index in the sparse_ array and the entity in dense_entities_.
    *
    * @param entity The entity ID representing the component.
    * @param component The component instance to insert.
    * @return Reference to the current ComponentArray for method chaining.
    */
-  ComponentArray& InsertData(Entity entity, T component);
+  ComponentArray& InsertData(Entity entity, const T& component);
+
+  /**
+   * @brief Inserts a component into the components_ by moving it.
+   *
+   * @param entity The entity ID representing the component.
+   * @param component The component instance to move into the array.
+   * @return Reference to the current ComponentArray for method chaining.
+   */
+  ComponentArray& InsertData(Entity entity, T&& component);
 
   /**
-   * @brief Removes a component from the component_array_.
+   * @brief Constructs a component in place at the end of the components_.
+   *
+   * @details
+   * Like InsertData(), but constructs the component from args directly in the
+   * array, avoiding any copy or move of a temporary.
+   *
+   * @tparam Args The constructor argument types of T.
+   * @param entity The entity ID representing the component.
+   * @param args The arguments forwarded to the constructor of T.
+   * @return Reference to the current ComponentArray for method chaining.
+   */
+  template <typename... Args>
+  ComponentArray& EmplaceData(Entity entity, Args&&... args);
+
+  /**
+   * @brief Removes a component from the components_.
    *
    * @details
    * Removes the component associated with the given entity ID from the
-   * component_array_, ensuring it stays packed, and cleans up the
-   * entity_to_index_map_ and index_to_entity_map_.
+   * components_, ensuring it stays packed by move-assigning the last element
+   * into the freed slot, and updates sparse_ and dense_entities_.
    *
-   * @param entity The entity ID to remove from the component_array_.
+   * @param entity The entity ID to remove from the components_.
    * @return Reference to the current ComponentArray for method chaining.
    */
   ComponentArray& RemoveData(Entity entity);
@@ -102,7 +226,7 @@ class ComponentArray : public GenericComponentArray {
    * @param entity The entity ID to which the component is associated.
    * @return A reference to the component if found.
    */
-  T& GetData(Entity entity);
+  reference GetData(Entity entity);
 
   /**
    * @brief Called when an entity has been destroyed and its data needs to be
@@ -113,6 +237,98 @@ class ComponentArray : public GenericComponentArray {
    */
   ComponentArray& EntityDestroyed(Entity entity) override;
 
+  /**
+   * @brief Swaps two packed entries, keeping sparse_ and dense_entities_ in
+   * sync.
+   *
+   * @param first The packed index of the first entry.
+   * @param second The packed index of the second entry.
+   * @return Reference to the current ComponentArray for method chaining.
+   */
+  ComponentArray& SwapEntries(size_t first, size_t second);
+
+  /**
+   * @brief Reorders the packed components so that iterating them follows
+   * compare.
+   *
+   * @details
+   * Components, entities and the sparse index are permuted together, so every
+   * entity keeps its own component. Only the packed order changes.
+   *
+   * @note Aborts if the array is owned by a Group, which relies on its own
+   * order.
+   *
+   * @tparam Compare Strict weak ordering called with two components, as T& or
+   * SoaReference<T>.
+   * @param compare Returns true if the first component goes before the second.
+   * @param strategy The sorting algorithm to use.
+   * @return Reference to the current ComponentArray for method chaining.
+   */
+  template <typename Compare>
+  ComponentArray& Sort(Compare compare,
+                       SortStrategy strategy = SortStrategy::kFull);
+
+  /**
+   * @brief Reorders the packed components by ascending entity ID.
+   *
+   * @param strategy The sorting algorithm to use.
+   * @return Reference to the current ComponentArray for method chaining.
+   */
+  ComponentArray& SortByEntity(SortStrategy strategy = SortStrategy::kFull);
+
+  /**
+   * @brief Returns the packed index of an entity's component.
+   *
+   * @note The entity must have a component in this array.
+   *
+   * @param entity The entity to look up.
+   * @return The index of the entity's component in the packed arrays.
+   */
+  size_t GetIndex(Entity entity) const { return sparse_.Get(entity); }
+
+  /**
+   * @brief Reserves room for capacity components, so that inserting up to that
+   * many does not reallocate.
+   *
+   * @param capacity The number of components to reserve room for.
+   * @return Reference to the current ComponentArray for method chaining.
+   */
+  ComponentArray& Reserve(size_t capacity);
+
+  /**
+   * @brief Releases the memory held beyond the current components.
+   *
+   * @details
+   * Removed components are destroyed right away, but the packed arrays keep
+   * their capacity for later insertions. Call this e.g. after unloading a
+   * level to hand that memory back. The sparse index frees its pages on its
+   * own once they are empty.
+   *
+   * @return Reference to the current ComponentArray for method chaining.
+   */
+  ComponentArray& ShrinkToFit() override;
+
+  /**
+   * @brief Returns the number of components that fit without reallocating.
+   *
+   * @return The capacity of the packed arrays.
+   */
+  size_t get_capacity() const { return components_.get_capacity(); }
+
+  /// @brief Returns the policy deciding when the array shrinks on its own.
+  ShrinkPolicy get_shrink_policy() const { return shrink_policy_; }
+
+  /**
+   * @brief Sets when the array releases unused capacity on its own.
+   *
+   * @param policy The policy checked after every removal.
+   * @return Reference to the current ComponentArray for method chaining.
+   */
+  ComponentArray& set_shrink_policy(ShrinkPolicy policy) override {
+    shrink_policy_ = policy;
+    return *this;
+  }
+
   /**
    * @brief Returns the number of valid entries in the array.
    *
@@ -120,18 +336,63 @@ class ComponentArray : public GenericComponentArray {
    */
   size_t get_size() const { return size_; }
 
+  /**
+   * @brief Returns the entities that have data, in packed order.
+   *
+   * @return A const reference to the dense entity array.
+   */
+  const std::pmr::vector<Entity>& get_entities() const {
+    return dense_entities_;
+  }
+
+  /**
+   * @brief Returns the packed component storage.
+   *
+   * @return A reference to the component storage.
+   */
+  ComponentStorage<T>& get_storage() { return components_; }
+
+  /// @brief Returns the owning group that orders this array, or nullptr.
+  GenericGroup* get_group() const { return group_; }
+
+  /**
+   * @brief Sets the owning group that is notified about insertions and
+   * removals.
+   *
+   * @param group The owning group, or nullptr to detach it.
+   * @return Reference to the current ComponentArray for method chaining.
+   */
+  ComponentArray& set_group(GenericGroup* group) {
+    group_ = group;
+    return *this;
+  }
+
  private:
-  /// @brief The packed array of components (of generic type T).
-  std::vector<T> component_array_;
+  /// @brief Marks an entity in sparse_ as not having a component.
+  static constexpr Entity kInvalidIndex = SparseIndex::kInvalidIndex;
+
+  /// @brief The packed components (of generic type T).
+  ComponentStorage<T> components_;
 
-  /// @brief Map from an entity ID to an array index.
-  std::unordered_map<Entity, size_t> entity_to_index_map_;
+  /// @brief Entity IDs in packed order, parallel to components_.
+  std::pmr::vector<Entity> dense_entities_;
 
-  /// @brief Map from an array index to an entity ID.
-  std::unordered_map<size_t, Entity> index_to_entity_map_;
+  /// @brief Packed index of each entity's component, keyed by entity ID.
+  SparseIndex sparse_;
 
   /// @brief Total size of valid entries in the array.
   size_t size_ = 0;
+
+  /// @brief The owning group that orders this array, if any.
+  GenericGroup* group_ = nullptr;
+
+  /// @brief When to release unused capacity after a removal.
+  ShrinkPolicy shrink_policy_{};
+
+  /// @brief Sorts packed indices with compare_indices(a, b) and applies the
+  /// resulting permutation.
+  template <typename CompareIndices>
+  void sort_indices(CompareIndices compare_indices, SortStrategy strategy);
 };
 
 }  // namespace ecs
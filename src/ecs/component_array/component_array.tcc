@@ -4,9 +4,12 @@
 #include <absl/log/check.h>
 #include <absl/log/log.h>
 
-#include <optional>
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <numeric>
 #include <typeinfo>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "src/ecs/component_array/component_array.h"
@@ -15,78 +18,199 @@
 namespace ecs {
 
 template <typename T>
-ComponentArray<T>& ComponentArray<T>::InsertData(Entity entity, T component) {
-  if (entity_to_index_map_.find(entity) != entity_to_index_map_.end()) {
+ComponentArray<T>& ComponentArray<T>::InsertData(Entity entity,
+                                                 const T& component) {
+  return EmplaceData(entity, component);
+}
+
+template <typename T>
+ComponentArray<T>& ComponentArray<T>::InsertData(Entity entity,
+                                                 T&& component) {
+  return EmplaceData(entity, std::move(component));
+}
+
+template <typename T>
+template <typename... Args>
+ComponentArray<T>& ComponentArray<T>::EmplaceData(Entity entity,
+                                                  Args&&... args) {
+  if (sparse_.Contains(entity)) {
     LOG(WARNING) << "Component of type '" << typeid(T).name()
                  << "' added to the same entity more than once.";
     return *this;
   }
 
-  // Put new entry at end and update the maps
+  // Put new entry at end and point the entity's sparse slot at it
   size_t new_index = size_;
 
-  entity_to_index_map_[entity] = new_index;
-  index_to_entity_map_[new_index] = entity;
-  if (new_index >= component_array_.size()) {
-    component_array_.push_back(component);
-  } else {
-    component_array_.at(new_index) = component;
-  }
+  sparse_.Set(entity, static_cast<Entity>(new_index));
+  dense_entities_.push_back(entity);
+  components_.EmplaceBack(std::forward<Args>(args)...);
   ++size_;
 
+  if (group_ != nullptr) {
+    group_->ComponentAdded(entity);
+  }
+
   return *this;
 }
 
 template <typename T>
 ComponentArray<T>& ComponentArray<T>::RemoveData(Entity entity) {
-  if (entity_to_index_map_.find(entity) == entity_to_index_map_.end()) {
+  if (!sparse_.Contains(entity)) {
     LOG(WARNING) << "Removing non-existent component of type '"
                  << typeid(T).name() << "'.";
     return *this;
   }
 
-  // Copy element at end into deleted element's place to maintain density
-  size_t index_of_removed_entity = entity_to_index_map_[entity];
-  size_t index_of_last_element = size_ - 1;
-  component_array_.at(index_of_removed_entity) =
-      component_array_.at(index_of_last_element);
+  // Let the owning group move the entry out of its range first
+  if (group_ != nullptr) {
+    group_->ComponentRemoving(entity);
+  }
+  Entity index_of_removed_entity = sparse_.Get(entity);
 
-  // Update map to point to moved spot
-  Entity entity_of_last_element = index_to_entity_map_[index_of_last_element];
-  entity_to_index_map_[entity_of_last_element] = index_of_removed_entity;
-  index_to_entity_map_[index_of_removed_entity] = entity_of_last_element;
+  // Move element at end into deleted element's place to maintain density
+  size_t index_of_last_element = size_ - 1;
+  Entity entity_of_last_element = dense_entities_[index_of_last_element];
+  if (index_of_removed_entity != index_of_last_element) {
+    components_.Move(index_of_removed_entity, index_of_last_element);
+  }
+  dense_entities_[index_of_removed_entity] = entity_of_last_element;
 
-  entity_to_index_map_.erase(entity);
-  index_to_entity_map_.erase(index_of_last_element);
+  // Point the moved entity at its new slot and clear the removed one
+  sparse_.Set(entity_of_last_element, index_of_removed_entity);
+  sparse_.Erase(entity);
+  dense_entities_.pop_back();
 
+  // Destroy the vacated last element so it releases what it owns
+  components_.PopBack();
   --size_;
 
+  size_t capacity = components_.get_capacity();
+  if (capacity > shrink_policy_.min_capacity &&
+      static_cast<float>(size_) <
+          shrink_policy_.min_load_factor * static_cast<float>(capacity)) {
+    ShrinkToFit();
+  }
+
   return *this;
 }
 
 template <typename T>
 bool ComponentArray<T>::HasData(Entity entity) const {
-  return entity_to_index_map_.find(entity) != entity_to_index_map_.end();
+  return sparse_.Contains(entity);
 }
 
 template <typename T>
-T& ComponentArray<T>::GetData(Entity entity) {
-  CHECK(entity_to_index_map_.find(entity) != entity_to_index_map_.end())
+typename ComponentArray<T>::reference ComponentArray<T>::GetData(
+    Entity entity) {
+  Entity index = sparse_.Get(entity);
+  CHECK(index != kInvalidIndex)
       << "Retrieving non-existent component of type '" << typeid(T).name()
       << "'.";
 
   // Return a reference to the entity's component
-  return component_array_.at(entity_to_index_map_[entity]);
+  return components_.Get(index);
+}
+
+template <typename T>
+ComponentArray<T>& ComponentArray<T>::SwapEntries(size_t first, size_t second) {
+  if (first == second) {
+    return *this;
+  }
+
+  components_.Swap(first, second);
+  std::swap(dense_entities_[first], dense_entities_[second]);
+  sparse_.Set(dense_entities_[first], static_cast<Entity>(first));
+  sparse_.Set(dense_entities_[second], static_cast<Entity>(second));
+
+  return *this;
+}
+
+template <typename T>
+template <typename Compare>
+ComponentArray<T>& ComponentArray<T>::Sort(Compare compare,
+                                           SortStrategy strategy) {
+  sort_indices(
+      [this, &compare](size_t first, size_t second) {
+        return compare(components_.Get(first), components_.Get(second));
+      },
+      strategy);
+  return *this;
+}
+
+template <typename T>
+ComponentArray<T>& ComponentArray<T>::SortByEntity(SortStrategy strategy) {
+  sort_indices(
+      [this](size_t first, size_t second) {
+        return dense_entities_[first] < dense_entities_[second];
+      },
+      strategy);
+  return *this;
+}
+
+template <typename T>
+ComponentArray<T>& ComponentArray<T>::Reserve(size_t capacity) {
+  components_.Reserve(capacity);
+  dense_entities_.reserve(capacity);
+  return *this;
+}
+
+template <typename T>
+ComponentArray<T>& ComponentArray<T>::ShrinkToFit() {
+  components_.ShrinkToFit();
+  dense_entities_.shrink_to_fit();
+  return *this;
 }
 
 template <typename T>
 ComponentArray<T>& ComponentArray<T>::EntityDestroyed(Entity entity) {
-  if (entity_to_index_map_.find(entity) != entity_to_index_map_.end()) {
+  if (sparse_.Contains(entity)) {
     // Remove the entity's component if it existed
     RemoveData(entity);
   }
   return *this;
 }
+
+// #########################
+// #        PRIVATE        #
+// #########################
+template <typename T>
+template <typename CompareIndices>
+void ComponentArray<T>::sort_indices(CompareIndices compare_indices,
+                                     SortStrategy strategy) {
+  CHECK(group_ == nullptr) << "Cannot sort component type '"
+                           << typeid(T).name()
+                           << "' while it is owned by a group.";
+
+  if (strategy == SortStrategy::kInsertion) {
+    // Cheap when only a few entries are out of place
+    for (size_t i = 1; i < size_; ++i) {
+      for (size_t j = i; j > 0 && compare_indices(j, j - 1); --j) {
+        SwapEntries(j, j - 1);
+      }
+    }
+    return;
+  }
+
+  // order[i] is the current index of the entry that belongs at i
+  std::pmr::vector<size_t> order(size_,
+                                 dense_entities_.get_allocator().resource());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), compare_indices);
+
+  // Apply the permutation one cycle at a time
+  for (size_t start = 0; start < size_; ++start) {
+    size_t current = start;
+    while (order[current] != start) {
+      size_t next = order[current];
+      SwapEntries(current, next);
+      order[current] = current;
+      current = next;
+    }
+    order[current] = current;
+  }
+}
+
 }  // namespace ecs
 
 #endif  // TBGE_ECS_COMPONENT_ARRAY_TCC_
@@ -0,0 +1,193 @@
+/**
+ * @file component_storage.h
+ * @brief Packed element storage used by ComponentArray.
+ *
+ * @details
+ * Stores the packed components of a ComponentArray either as an array of
+ * structs, or as a structure of arrays for components that specialize
+ * SoaTraits.
+ */
+
+#ifndef TBGE_ECS_COMPONENT_STORAGE_H_
+#define TBGE_ECS_COMPONENT_STORAGE_H_
+
+#include <cstddef>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "src/ecs/component/soa.h"
+
+namespace ecs {
+
+/**
+ * @brief Array of structs storage for components of type T.
+ *
+ * @tparam T The component type.
+ */
+template <typename T>
+class ComponentStorage {
+ public:
+  /// @brief The type handed out when accessing an element.
+  using reference = T&;
+
+  /// @brief Constructs an empty storage allocating from resource.
+  explicit ComponentStorage(std::pmr::memory_resource* resource)
+      : components_(resource) {}
+
+  /// @brief Returns the element at index.
+  reference Get(size_t index) { return components_[index]; }
+
+  /// @brief Constructs a new element at the end from args.
+  template <typename... Args>
+  void EmplaceBack(Args&&... args) {
+    components_.emplace_back(std::forward<Args>(args)...);
+  }
+
+  /// @brief Destroys the last element.
+  void PopBack() { components_.pop_back(); }
+
+  /// @brief Moves the element at source over the element at destination.
+  void Move(size_t destination, size_t source) {
+    components_[destination] = std::move(components_[source]);
+  }
+
+  /// @brief Swaps the elements at first and second.
+  void Swap(size_t first, size_t second) {
+    std::swap(components_[first], components_[second]);
+  }
+
+  /// @brief Reserves room for capacity elements.
+  void Reserve(size_t capacity) { components_.reserve(capacity); }
+
+  /// @brief Releases the memory held beyond the current elements.
+  void ShrinkToFit() { components_.shrink_to_fit(); }
+
+  /// @brief Returns the number of elements that fit without reallocating.
+  size_t get_capacity() const { return components_.capacity(); }
+
+ private:
+  std::pmr::vector<T> components_;
+};
+
+/**
+ * @brief Structure of arrays storage for components that specialize
+ * SoaTraits.
+ *
+ * @details
+ * Keeps one contiguous std::vector per field listed in SoaTraits<T>::kFields.
+ * Elements are handed out as SoaReference proxies.
+ *
+ * @tparam T The component type.
+ */
+template <SoaComponent T>
+class ComponentStorage<T> {
+ public:
+  /// @brief The type handed out when accessing an element.
+  using reference = SoaReference<T>;
+
+  /// @brief Constructs an empty storage whose columns allocate from resource.
+  explicit ComponentStorage(std::pmr::memory_resource* resource)
+      : columns_(make_columns(
+            resource,
+            std::make_index_sequence<soa_internal::kFieldCount<T>>{})) {}
+
+  /// @brief Returns a proxy to the element at index.
+  reference Get(size_t index) {
+    return std::apply(
+        [index](auto&... columns) {
+          return reference(
+              typename reference::FieldPointers{&columns[index]...});
+        },
+        columns_);
+  }
+
+  /// @brief Constructs a new element at the end from args.
+  ///
+  /// @details The component is constructed whole and its fields are then moved
+  /// into the columns.
+  template <typename... Args>
+  void EmplaceBack(Args&&... args) {
+    T component(std::forward<Args>(args)...);
+    [&]<size_t... Is>(std::index_sequence<Is...>) {
+      (get_column<Is>().push_back(
+           std::move(component.*std::get<Is>(SoaTraits<T>::kFields))),
+       ...);
+    }(std::make_index_sequence<soa_internal::kFieldCount<T>>{});
+  }
+
+  /// @brief Destroys the last element of every column.
+  void PopBack() {
+    std::apply([](auto&... columns) { (columns.pop_back(), ...); }, columns_);
+  }
+
+  /// @brief Moves the element at source over the element at destination.
+  void Move(size_t destination, size_t source) {
+    std::apply(
+        [&](auto&... columns) {
+          ((columns[destination] = std::move(columns[source])), ...);
+        },
+        columns_);
+  }
+
+  /// @brief Swaps the elements at first and second.
+  void Swap(size_t first, size_t second) {
+    std::apply(
+        [&](auto&... columns) {
+          (std::swap(columns[first], columns[second]), ...);
+        },
+        columns_);
+  }
+
+  /// @brief Reserves room for capacity elements in every column.
+  void Reserve(size_t capacity) {
+    std::apply(
+        [capacity](auto&... columns) { (columns.reserve(capacity), ...); },
+        columns_);
+  }
+
+  /// @brief Releases the memory held beyond the current elements in every
+  /// column.
+  void ShrinkToFit() {
+    std::apply([](auto&... columns) { (columns.shrink_to_fit(), ...); },
+               columns_);
+  }
+
+  /// @brief Returns the number of elements that fit without reallocating.
+  size_t get_capacity() const { return std::get<0>(columns_).capacity(); }
+
+  /// @brief Returns the contiguous array holding field I of every element.
+  template <size_t I>
+  std::pmr::vector<soa_internal::FieldType<T, I>>& get_column() {
+    return std::get<I>(columns_);
+  }
+
+ private:
+  template <typename Field>
+  using Column = std::pmr::vector<Field>;
+
+  using Columns = typename soa_internal::MapFields<T, Column>::type;
+
+  Columns columns_;
+
+  template <size_t... Is>
+  static Columns make_columns(std::pmr::memory_resource* resource,
+                              std::index_sequence<Is...>) {
+    return Columns(std::tuple_element_t<Is, Columns>(resource)...);
+  }
+
+  static_assert(soa_internal::kFieldCount<T> > 0,
+                "SoaTraits<T>::kFields must list at least one field.");
+  static_assert(
+      []<size_t... Is>(std::index_sequence<Is...>) {
+        return (!std::is_same_v<soa_internal::FieldType<T, Is>, bool> && ...);
+      }(std::make_index_sequence<soa_internal::kFieldCount<T>>{}),
+      "bool fields cannot be stored as a structure of arrays because "
+      "std::vector<bool> does not hand out references.");
+};
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_COMPONENT_STORAGE_H_
@@ -0,0 +1,98 @@
+/**
+ * @file soa_view.h
+ * @brief Field-level access to a ComponentArray stored as a structure of
+ * arrays.
+ */
+
+#ifndef TBGE_ECS_SOA_VIEW_H_
+#define TBGE_ECS_SOA_VIEW_H_
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "src/ecs/component/soa.h"
+#include "src/ecs/component_array/component_array.h"
+#include "src/ecs/context/context.h"
+
+namespace ecs {
+
+/**
+ * @brief Non-owning view over the packed columns of a SoA ComponentArray.
+ *
+ * @details
+ * Exposes each field as a contiguous span so that kernels can loop over one
+ * field at a time, e.g. for auto-vectorization, without touching the others.
+ * Index i of every column and of entities() belongs to the same component.
+ *
+ * Example:
+ * @code
+ *   auto view = coordinator.GetSoaView<Velocity>();
+ *   std::span<float> dx = view.column<&Velocity::dx>();
+ *   for (size_t i = 0; i < view.size(); ++i) {
+ *     dx[i] *= damping;
+ *   }
+ * @endcode
+ *
+ * @note The spans are invalidated by adding or removing components of type T.
+ *
+ * @tparam T A component type that specializes SoaTraits.
+ */
+template <SoaComponent T>
+class SoaView {
+ public:
+  /**
+   * @brief Constructs a view over a component array.
+   *
+   * @param component_array The array to view. Must outlive the view.
+   */
+  explicit SoaView(ComponentArray<T>& component_array)
+      : component_array_(&component_array) {}
+
+  /// @brief Returns the number of components in the view.
+  size_t size() const { return component_array_->get_size(); }
+
+  /// @brief Returns the entity owning each packed index.
+  std::span<const Entity> entities() const {
+    return {component_array_->get_entities().data(), size()};
+  }
+
+  /// @brief Returns field I of every component as a contiguous span.
+  template <size_t I>
+  std::span<soa_internal::FieldType<T, I>> column() const {
+    return {component_array_->get_storage().template get_column<I>().data(),
+            size()};
+  }
+
+  /// @brief Returns the field identified by a pointer to data member of every
+  /// component as a contiguous span.
+  template <auto Member>
+    requires std::is_member_object_pointer_v<decltype(Member)>
+  auto column() const {
+    constexpr size_t index = soa_internal::FieldIndex<T, Member>(
+        std::make_index_sequence<soa_internal::kFieldCount<T>>{});
+    static_assert(index < soa_internal::kFieldCount<T>,
+                  "Member is not listed in SoaTraits<T>::kFields.");
+    return column<index>();
+  }
+
+  /**
+   * @brief Returns a proxy reference to the component of an entity.
+   *
+   * @note Will abort if the entity does not have a component of type T.
+   *
+   * @param entity The entity whose component is returned.
+   * @return A SoaReference to the entity's component.
+   */
+  SoaReference<T> operator[](Entity entity) const {
+    return component_array_->GetData(entity);
+  }
+
+ private:
+  ComponentArray<T>* component_array_;
+};
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_SOA_VIEW_H_
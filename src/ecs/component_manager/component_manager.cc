@@ -1,12 +1,58 @@
 #include "src/ecs/component_manager/component_manager.h"
 
+#include <memory_resource>
+
+#include "src/ecs/memory/memory.h"
+
 namespace ecs {
 
+ComponentManager::ComponentManager(StorageMode storage_mode,
+                                   std::pmr::memory_resource* resource)
+    : resource_(resource),
+      component_types_(resource),
+      component_type_by_index_(resource),
+      component_arrays_(resource),
+      groups_(resource),
+      storage_mode_(storage_mode) {
+  if (storage_mode_ == StorageMode::kArchetypes) {
+    archetype_storage_ =
+        MakeResourcePtr<ArchetypeStorage>(resource_, resource_);
+  }
+}
+
 ComponentManager& ComponentManager::EntityDestroyed(Entity entity) {
+  if (archetype_storage_) {
+    archetype_storage_->EntityDestroyed(entity);
+    return *this;
+  }
+
   // Notify each component array that an entity has been destroyed
   // If it has a component for that entity, it will remove it
-  for (auto const& [type_name, component] : component_arrays_) {
-    component->EntityDestroyed(entity);
+  for (auto const& component_array : component_arrays_) {
+    if (component_array != nullptr) {
+      component_array->EntityDestroyed(entity);
+    }
+  }
+
+  return *this;
+}
+
+ComponentManager& ComponentManager::Compact() {
+  for (auto const& component_array : component_arrays_) {
+    if (component_array != nullptr) {
+      component_array->ShrinkToFit();
+    }
+  }
+
+  return *this;
+}
+
+ComponentManager& ComponentManager::set_shrink_policy(ShrinkPolicy policy) {
+  shrink_policy_ = policy;
+  for (auto const& component_array : component_arrays_) {
+    if (component_array != nullptr) {
+      component_array->set_shrink_policy(policy);
+    }
   }
 
   return *this;
@@ -10,14 +10,38 @@
 #ifndef TBGE_ECS_COMPONENT_MANAGER_H_
 #define TBGE_ECS_COMPONENT_MANAGER_H_
 
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <span>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "src/ecs/archetype/archetype_storage.h"
+#include "src/ecs/component/soa.h"
+#include "src/ecs/component/tag.h"
 #include "src/ecs/component_array/component_array.h"
+#include "src/ecs/component_array/soa_view.h"
 #include "src/ecs/context/context.h"
+#include "src/ecs/group/group.h"
+#include "src/ecs/memory/memory.h"
+#include "src/ecs/type_index/type_index.h"
+#include "src/ecs/view/view.h"
 
 namespace ecs {
 
+/**
+ * @brief Selects how a ComponentManager stores component data.
+ */
+enum class StorageMode {
+  /// One packed ComponentArray per component type.
+  kComponentArrays,
+  /// Entities with the same Signature share chunks with one column per
+  /// component type. See ArchetypeStorage.
+  kArchetypes,
+};
+
 /**
  * @class ComponentManager
  * @brief Manages registration, storage, and retrieval of components in this ECS
@@ -29,9 +53,23 @@ namespace ecs {
  * - Adding, removing, and retrieving components for entities.
  * - Managing the lifecycle of components when entities are destroyed.
  * - Providing type-safe access to component arrays.
+ *
+ * Component data is either kept in one ComponentArray per type or in an
+ * ArchetypeStorage, depending on the StorageMode the manager is built with.
  */
 class ComponentManager {
  public:
+  /**
+   * @brief Constructs a ComponentManager using the given storage backend.
+   *
+   * @param storage_mode How component data is stored.
+   * @param resource The memory resource all component storage is allocated
+   * from. Must outlive the manager.
+   */
+  explicit ComponentManager(
+      StorageMode storage_mode = StorageMode::kComponentArrays,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
   /**
    * @brief Registers a new component type.
    *
@@ -64,6 +102,45 @@ class ComponentManager {
   template <typename T>
   ComponentManager& AddComponent(Entity entity, T component);
 
+  /**
+   * @brief Constructs a component of type T in place for an entity.
+   *
+   * @tparam T The type of the component to construct.
+   * @tparam Args The constructor argument types of T.
+   * @param entity The Entity ID the component should be associated with
+   * @param args The arguments forwarded to the constructor of T
+   * @return Reference to the current ECS::ComponentManager for method chaining.
+   */
+  template <typename T, typename... Args>
+  ComponentManager& EmplaceComponent(Entity entity, Args&&... args);
+
+  /**
+   * @brief Adds one component of type T to each of many entities.
+   *
+   * @details
+   * Reserves room in the ComponentArray once for the whole batch.
+   *
+   * @tparam T The type of the components.
+   * @param entities The entities the components are added to.
+   * @param components The component for each entity, in the same order.
+   * @return Reference to the current ECS::ComponentManager for method chaining.
+   */
+  template <typename T>
+  ComponentManager& AddComponents(std::span<const Entity> entities,
+                                  std::span<const T> components);
+
+  /**
+   * @brief Adds a copy of prototype to each of many entities.
+   *
+   * @tparam T The type of the component.
+   * @param entities The entities the component is added to.
+   * @param prototype The component copied to every entity.
+   * @return Reference to the current ECS::ComponentManager for method chaining.
+   */
+  template <typename T>
+  ComponentManager& AddComponents(std::span<const Entity> entities,
+                                  const T& prototype);
+
   /**
    * @brief Removes a component from the correct ComponentArray based on the
    * type.
@@ -91,10 +168,11 @@ class ComponentManager {
    *
    * @tparam T The type of the component.
    * @param entity The Entity ID of the component that is being retrieved.
-   * @return The component of type T
+   * @return The component of type T, as a T& or as a SoaReference<T> for
+   * components that specialize SoaTraits.
    */
   template <typename T>
-  T& GetComponent(Entity entity);
+  ComponentReference<T> GetComponent(Entity entity);
 
   /**
    * @brief Retrieves the entity associated with a component instance.
@@ -118,35 +196,172 @@ class ComponentManager {
    */
   ComponentManager& EntityDestroyed(Entity entity);
 
+  /**
+   * @brief Releases the unused capacity of every ComponentArray.
+   *
+   * @note Does nothing with StorageMode::kArchetypes, where archetypes free
+   * their chunks as soon as they empty.
+   *
+   * @return Reference to the current ECS::ComponentManager for method chaining.
+   */
+  ComponentManager& Compact();
+
+  /**
+   * @brief Calls func(entity, components...) for every entity that has all of
+   * the component types Ts.
+   *
+   * @details
+   * With StorageMode::kArchetypes this is a linear scan over the chunks of the
+   * matching archetypes. With StorageMode::kComponentArrays it iterates a
+   * View over the ComponentArrays of Ts.
+   *
+   * @note func must not add or remove components or destroy entities.
+   *
+   * @tparam Ts The component types to visit.
+   * @tparam Func Callable taking (Entity, ComponentReference<Ts>...).
+   * @param func The function to call for every matching entity.
+   * @return Reference to the current ECS::ComponentManager for method chaining.
+   */
+  template <typename... Ts, typename Func>
+  ComponentManager& Each(Func&& func);
+
+  /**
+   * @brief Returns the ComponentArray holding every component of type T.
+   *
+   * @details
+   * The reference stays valid for the lifetime of the manager, so callers can
+   * look a pool up once and use it directly afterwards without going through
+   * the type lookup on every access.
+   *
+   * @note Aborts when the manager uses StorageMode::kArchetypes.
+   *
+   * @tparam T The component type.
+   * @return The ComponentArray of type T.
+   */
+  template <typename T>
+  ComponentArray<T>& GetPool();
+
+  /**
+   * @brief Returns the owning group of component types Ts, creating it on the
+   * first call.
+   *
+   * @note Aborts when the manager uses StorageMode::kArchetypes, or when one
+   * of the ComponentArrays is already owned by a different group.
+   *
+   * @tparam Ts The component types owned by the group.
+   * @return The group of Ts, owned by the manager.
+   */
+  template <typename... Ts>
+  Group<Ts...>& GetGroup();
+
+  /**
+   * @brief Returns a view over the field columns of a component type stored as
+   * a structure of arrays.
+   *
+   * @note Aborts when the manager uses StorageMode::kArchetypes.
+   *
+   * @tparam T A component type that specializes SoaTraits.
+   * @return A view over the ComponentArray of type T.
+   */
+  template <SoaComponent T>
+  SoaView<T> GetSoaView();
+
   /**
    * @brief Retrieves the mapping of component type names to their corresponding
    * component types.
    *
-   * @return An unordered map where the key is a C-string representing the
-   * component type name, and the value is the associated component type as
-   * defined in the Context.
+   * @note Only meant for introspection and debugging. Lookups by type go
+   * through the dense type index instead.
+   *
+   * @return An unordered map where the key is the component type name, and
+   * the value is the associated component type as defined in the Context.
    */
-  const std::unordered_map<const char*, ComponentTypeId>& get_component_types()
-      const {
+  const std::pmr::unordered_map<std::pmr::string, ComponentTypeId>&
+  get_component_types() const {
     return component_types_;
   }
 
   /// @brief Convenience function to get the statically casted pointer to the
   /// ComponentArray of type T.
+  ///
+  /// @note Aborts when the manager uses StorageMode::kArchetypes.
   template <typename T>
-  std::shared_ptr<ComponentArray<T>> get_component_array();
+  ComponentArray<T>* get_component_array();
+
+  /// @brief Returns the shrink policy given to every ComponentArray.
+  ShrinkPolicy get_shrink_policy() const { return shrink_policy_; }
+
+  /**
+   * @brief Sets the shrink policy of every ComponentArray, including those of
+   * component types registered later.
+   *
+   * @param policy The policy the arrays check after every removal.
+   * @return Reference to the current ECS::ComponentManager for method chaining.
+   */
+  ComponentManager& set_shrink_policy(ShrinkPolicy policy);
+
+  /// @brief Returns the storage backend in use.
+  StorageMode get_storage_mode() const { return storage_mode_; }
+
+  /// @brief Returns the archetype storage, or nullptr when the manager uses
+  /// StorageMode::kComponentArrays.
+  ArchetypeStorage* get_archetype_storage() {
+    return archetype_storage_.get();
+  }
 
  private:
-  /// @brief Map from typename to a component type
-  std::unordered_map<const char*, ComponentTypeId> component_types_{};
+  /// @brief Dense indices of component types, shared by all managers.
+  using ComponentTypeIndex = TypeIndex<struct ComponentTypeFamily>;
+
+  /// @brief Marks a type index that has no component type in this manager.
+  static constexpr ComponentTypeId kUnregistered =
+      std::numeric_limits<ComponentTypeId>::max();
+
+  /// @brief Resource every array, group and archetype is allocated from.
+  std::pmr::memory_resource* resource_;
+
+  /// @brief Map from typename to a component type, for introspection
+  std::pmr::unordered_map<std::pmr::string, ComponentTypeId> component_types_;
 
-  /// @brief Map from typename to a component array
-  std::unordered_map<const char*, std::shared_ptr<GenericComponentArray>>
-      component_arrays_{};
+  /// @brief Component type of each ComponentTypeIndex, or kUnregistered
+  std::pmr::vector<ComponentTypeId> component_type_by_index_;
+
+  /// @brief Component arrays indexed by component type, nullptr for tags.
+  /// Each array is allocated separately so its address never changes.
+  std::pmr::vector<ResourcePtr<GenericComponentArray>> component_arrays_;
 
   /// @brief The component type to be assigned to the next registered component
   /// - starting at 0
   ComponentTypeId next_component_type_{};
+
+  /// @brief Dense indices of group types, shared by all managers.
+  using GroupTypeIndex = TypeIndex<struct GroupTypeFamily>;
+
+  /// @brief Owning groups indexed by GroupTypeIndex. Declared after
+  /// component_arrays_ so groups are destroyed before the arrays they own.
+  std::pmr::vector<ResourcePtr<GenericGroup>> groups_;
+
+  /// @brief Shrink policy handed to every ComponentArray.
+  ShrinkPolicy shrink_policy_{};
+
+  /// @brief How component data is stored.
+  StorageMode storage_mode_;
+
+  /// @brief Archetype backend, only created for StorageMode::kArchetypes.
+  ResourcePtr<ArchetypeStorage> archetype_storage_;
+
+  /// @brief Returns the component type ID of T, registering T with a warning
+  /// if it has not been registered yet.
+  template <typename T>
+  ComponentTypeId ensure_registered();
+
+  /// @brief Returns the component type registered for a type index, or
+  /// kUnregistered.
+  ComponentTypeId find_component_type(size_t type_index) const {
+    return type_index < component_type_by_index_.size()
+               ? component_type_by_index_[type_index]
+               : kUnregistered;
+  }
 };
 
 }  // namespace ECS
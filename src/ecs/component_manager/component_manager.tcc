@@ -5,31 +5,59 @@
 #include <absl/log/log.h>
 
 #include <memory>
+#include <span>
+#include <tuple>
 #include <typeinfo>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "src/ecs/archetype/archetype.h"
+#include "src/ecs/archetype/archetype_storage.h"
+#include "src/ecs/component/soa.h"
 #include "src/ecs/component_array/component_array.h"
+#include "src/ecs/component_array/soa_view.h"
 #include "src/ecs/component_manager/component_manager.h"
 #include "src/ecs/context/context.h"
+#include "src/ecs/group/group.h"
+#include "src/ecs/type_index/type_index.h"
+#include "src/ecs/view/view.h"
 
 namespace ecs {
 
 template <typename T>
 ComponentManager& ComponentManager::RegisterComponentType() {
-  const char* type_name = typeid(T).name();
+  size_t type_index = ComponentTypeIndex::Get<T>();
 
-  if (component_types_.find(type_name) != component_types_.end()) {
+  if (find_component_type(type_index) != kUnregistered) {
     LOG(WARNING) << "Registering component type more than once. Component type "
                     "registered twice has typeid \""
-                 << type_name << "\". Operation ignored.";
+                 << typeid(T).name() << "\". Operation ignored.";
     return *this;
   }
 
-  // Add this component type to the component type map
-  component_types_.insert({type_name, next_component_type_});
+  // Map the type index to this component type
+  if (type_index >= component_type_by_index_.size()) {
+    component_type_by_index_.resize(type_index + 1, kUnregistered);
+  }
+  component_type_by_index_[type_index] = next_component_type_;
+  component_types_.emplace(typeid(T).name(), next_component_type_);
 
-  // Create a ComponentArray pointer and add it to the component arrays map
-  component_arrays_.insert({type_name, std::make_shared<ComponentArray<T>>()});
+  if (archetype_storage_) {
+    // Archetypes only need to know how to move and destroy the type
+    if constexpr (!TagComponent<T>) {
+      archetype_storage_->RegisterComponentType(next_component_type_,
+                                                MakeComponentTypeInfo<T>());
+    }
+  } else if constexpr (TagComponent<T>) {
+    // Tags are only signature bits, keep their slot empty
+    component_arrays_.push_back(nullptr);
+  } else {
+    // The array's position in component_arrays_ is its component type
+    component_arrays_.push_back(
+        MakeResourcePtr<ComponentArray<T>, GenericComponentArray>(resource_,
+                                                                  resource_));
+    component_arrays_.back()->set_shrink_policy(shrink_policy_);
+  }
 
   // Increment the value so that the next component registered will be different
   ++next_component_type_;
@@ -39,57 +67,202 @@ ComponentManager& ComponentManager::RegisterComponentType() {
 
 template <typename T>
 ComponentTypeId ComponentManager::GetComponentTypeId() {
-  const char* type_name = typeid(T).name();
+  ComponentTypeId component_type =
+      find_component_type(ComponentTypeIndex::Get<T>());
 
-  CHECK(component_types_.find(type_name) != component_types_.end())
-      << "Component of type " << type_name << " not registered before use.";
+  CHECK(component_type != kUnregistered)
+      << "Component of type " << typeid(T).name()
+      << " not registered before use.";
 
   // Return this component's type - used for creating signatures
-  return component_types_[type_name];
+  return component_type;
 }
 
 template <typename T>
 ComponentManager& ComponentManager::AddComponent(Entity entity, T component) {
-  // Add a component to the array for an entity
-  get_component_array<T>()->InsertData(entity, component);
+  return EmplaceComponent<T>(entity, std::move(component));
+}
+
+template <typename T, typename... Args>
+ComponentManager& ComponentManager::EmplaceComponent(Entity entity,
+                                                     Args&&... args) {
+  // Tags only live in the entity's signature
+  if constexpr (TagComponent<T>) {
+    ensure_registered<T>();
+  } else if (archetype_storage_) {
+    archetype_storage_->EmplaceComponent<T>(entity, ensure_registered<T>(),
+                                            std::forward<Args>(args)...);
+  } else {
+    // Construct a component in the array for an entity
+    get_component_array<T>()->EmplaceData(entity,
+                                          std::forward<Args>(args)...);
+  }
+
+  return *this;
+}
+
+template <typename T>
+ComponentManager& ComponentManager::AddComponents(
+    std::span<const Entity> entities, std::span<const T> components) {
+  CHECK(entities.size() == components.size())
+      << "AddComponents needs exactly one component of type '"
+      << typeid(T).name() << "' per entity.";
+
+  if constexpr (TagComponent<T>) {
+    ensure_registered<T>();
+  } else if (archetype_storage_) {
+    ComponentTypeId component_type = ensure_registered<T>();
+    for (size_t i = 0; i < entities.size(); ++i) {
+      archetype_storage_->EmplaceComponent<T>(entities[i], component_type,
+                                              components[i]);
+    }
+  } else {
+    ComponentArray<T>* component_array = get_component_array<T>();
+    component_array->Reserve(component_array->get_size() + entities.size());
+    for (size_t i = 0; i < entities.size(); ++i) {
+      component_array->InsertData(entities[i], components[i]);
+    }
+  }
+
+  return *this;
+}
+
+template <typename T>
+ComponentManager& ComponentManager::AddComponents(
+    std::span<const Entity> entities, const T& prototype) {
+  if constexpr (TagComponent<T>) {
+    ensure_registered<T>();
+  } else if (archetype_storage_) {
+    ComponentTypeId component_type = ensure_registered<T>();
+    for (Entity entity : entities) {
+      archetype_storage_->EmplaceComponent<T>(entity, component_type,
+                                              prototype);
+    }
+  } else {
+    ComponentArray<T>* component_array = get_component_array<T>();
+    component_array->Reserve(component_array->get_size() + entities.size());
+    for (Entity entity : entities) {
+      component_array->InsertData(entity, prototype);
+    }
+  }
 
   return *this;
 }
 
 template <typename T>
 ComponentManager& ComponentManager::RemoveComponent(Entity entity) {
-  // Remove a component from the array for an entity
-  get_component_array<T>()->RemoveData(entity);
+  if constexpr (TagComponent<T>) {
+    ensure_registered<T>();
+  } else if (archetype_storage_) {
+    archetype_storage_->RemoveComponent(entity, ensure_registered<T>());
+  } else {
+    // Remove a component from the array for an entity
+    get_component_array<T>()->RemoveData(entity);
+  }
 
   return *this;
 }
 
 template <typename T>
 bool ComponentManager::HasComponent(Entity entity) {
+  static_assert(!TagComponent<T>,
+                "Tags are only stored in the entity Signature. Use "
+                "Coordinator::HasComponent().");
+
+  if (archetype_storage_) {
+    return archetype_storage_->HasComponent(entity, ensure_registered<T>());
+  }
+
   return get_component_array<T>()->HasData(entity);
 }
 
 template <typename T>
-T& ComponentManager::GetComponent(Entity entity) {
+ComponentReference<T> ComponentManager::GetComponent(Entity entity) {
+  static_assert(!TagComponent<T>,
+                "Tags are only stored in the entity Signature. Use "
+                "Coordinator::GetComponent().");
+
+  if (archetype_storage_) {
+    return MakeComponentReference<T>(
+        archetype_storage_->GetComponent<T>(entity, ensure_registered<T>()));
+  }
+
   // Get a reference to a component from the array for an entity
   return get_component_array<T>()->GetData(entity);
 }
 
+template <typename... Ts, typename Func>
+ComponentManager& ComponentManager::Each(Func&& func) {
+  static_assert((!TagComponent<Ts> && ...),
+                "Tags are only stored in the entity Signature. Use "
+                "Coordinator::Each().");
+
+  if (archetype_storage_) {
+    archetype_storage_->Each<Ts...>(
+        {ensure_registered<Ts>()...},
+        [&func](Entity entity, Ts&... components) {
+          func(entity, MakeComponentReference<Ts>(components)...);
+        });
+    return *this;
+  }
+
+  View<Ts...>(*get_component_array<Ts>()...).each(std::forward<Func>(func));
+
+  return *this;
+}
+
+template <typename T>
+ComponentArray<T>& ComponentManager::GetPool() {
+  static_assert(!TagComponent<T>, "Tags have no pool.");
+  return *get_component_array<T>();
+}
+
+template <typename... Ts>
+Group<Ts...>& ComponentManager::GetGroup() {
+  size_t group_index = GroupTypeIndex::Get<Group<Ts...>>();
+  if (group_index >= groups_.size()) {
+    groups_.resize(group_index + 1);
+  }
+
+  if (groups_[group_index] == nullptr) {
+    groups_[group_index] = MakeResourcePtr<Group<Ts...>, GenericGroup>(
+        resource_, *get_component_array<Ts>()...);
+  }
+
+  return static_cast<Group<Ts...>&>(*groups_[group_index]);
+}
+
+template <SoaComponent T>
+SoaView<T> ComponentManager::GetSoaView() {
+  return SoaView<T>(*get_component_array<T>());
+}
+
 // #########################
 // #        PRIVATE        #
 // #########################
 template <typename T>
-std::shared_ptr<ComponentArray<T>> ComponentManager::get_component_array() {
-  const char* type_name = typeid(T).name();
+ComponentArray<T>* ComponentManager::get_component_array() {
+  CHECK(!archetype_storage_)
+      << "ComponentArrays are not used by a ComponentManager in archetype "
+         "storage mode.";
+
+  return static_cast<ComponentArray<T>*>(
+      component_arrays_[ensure_registered<T>()].get());
+}
+
+template <typename T>
+ComponentTypeId ComponentManager::ensure_registered() {
+  size_t type_index = ComponentTypeIndex::Get<T>();
 
-  if (component_types_.find(type_name) == component_types_.end()) {
-    LOG(WARNING) << "Component with typename \"" << std::string(type_name)
+  ComponentTypeId component_type = find_component_type(type_index);
+  if (component_type == kUnregistered) {
+    LOG(WARNING) << "Component with typename \"" << typeid(T).name()
                  << "\" not registered before access. Registering now.";
     RegisterComponentType<T>();
+    component_type = find_component_type(type_index);
   }
 
-  return std::static_pointer_cast<ComponentArray<T>>(
-      component_arrays_[type_name]);
+  return component_type;
 }
 
 }  // namespace ECS
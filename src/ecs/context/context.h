@@ -7,8 +7,12 @@
  * ComponentTypeId, Signature) with compile-time configuration options.
  * Configuration macros:
  * - ECS_ENTITY_CONFIG: Entity ID size in bits (8, 16, 32, or 64)
+ * - ECS_ENTITY_GENERATION_BITS: Bits of an EntityHandle used for the
+ *   generation counter
  * - ECS_COMPONENT_CONFIG: Component type ID size in bits (8, 16, or 32)
  * - ECS_MAX_COMPONENT_TYPES: Maximum number of component types (0 < n <= 65536)
+ * - ECS_SPARSE_PAGE_SIZE: Entries per page of entity-indexed sparse arrays
+ * - ECS_ARCHETYPE_CHUNK_SIZE: Size in bytes of an archetype storage chunk
  */
 
 #ifndef TBGE_ECS_CONTEXT_H_
@@ -24,10 +28,11 @@
 #endif  // min
 #endif  // _WIN32
 
-#include <bitset>
 #include <cstdint>
 #include <limits>
 
+#include "src/ecs/signature/signature.h"
+
 namespace ecs {
 
 /**
@@ -42,6 +47,17 @@ namespace ecs {
  *   - Supported values: 8, 16, 32, 64
  *   - Maps to `Entity` type
  *
+ * - `ECS_ENTITY_GENERATION_BITS`: Generation bits of an EntityHandle
+ *   (default: 0)
+ *   - Must be smaller than ECS_ENTITY_CONFIG
+ *   - The remaining bits hold the entity ID, so they also bound the number of
+ *     entities: with 32-bit entities, 8 generation bits leave room for about
+ *     16.7 million entities instead of 4.29 billion
+ *   - 0 disables generations, handles then only check that the ID is in use
+ *     and cannot tell a destroyed entity from a new one that reused its ID
+ *   - Opt in when handles outlive the entities they refer to, e.g. targets
+ *     kept by AI components, and the smaller ID range is acceptable
+ *
  * - `ECS_COMPONENT_CONFIG`: Component type ID size in bits (default: 16)
  *   - Supported values: 8, 16, 32
  *   - Maps to `ComponentTypeId` type
@@ -50,6 +66,18 @@ namespace ecs {
  * 1024)
  *   - Used for `Signature` bitset size
  *   - Must be a compile-time constant
+ *   - A Signature takes ceil(n / 64) * 8 bytes per entity, and signatures of
+ *     up to 128 bits use the fastest matching path, so set it close to the
+ *     number of component types the game registers
+ *
+ * - `ECS_SPARSE_PAGE_SIZE`: Entries per page of a SparseIndex (default: 4096)
+ *   - Must be a power of two
+ *   - Smaller pages waste less memory on scattered entity IDs, larger pages
+ *     keep the page directory shorter
+ *
+ * - `ECS_ARCHETYPE_CHUNK_SIZE`: Bytes per archetype chunk (default: 16384)
+ *   - Only used when a Coordinator is built with StorageMode::kArchetypes
+ *   - Archetypes whose single row does not fit get chunks of one row
  *
  * @note Define these macros before including ECS headers if you want
  * different size configurations.
@@ -61,6 +89,10 @@ namespace ecs {
 #define ECS_ENTITY_CONFIG 32
 #endif  // ECS_ENTITY_CONFIG
 
+#ifndef ECS_ENTITY_GENERATION_BITS
+#define ECS_ENTITY_GENERATION_BITS 0
+#endif  // ECS_ENTITY_GENERATION_BITS
+
 #ifndef ECS_COMPONENT_CONFIG
 #define ECS_COMPONENT_CONFIG 16
 #endif  // ECS_COMPONENT_CONFIG
@@ -69,12 +101,25 @@ namespace ecs {
 #define ECS_MAX_COMPONENT_TYPES 1024
 #endif  // ECS_MAX_COMPONENT_TYPES
 
+#ifndef ECS_SPARSE_PAGE_SIZE
+#define ECS_SPARSE_PAGE_SIZE 4096
+#endif  // ECS_SPARSE_PAGE_SIZE
+
+#ifndef ECS_ARCHETYPE_CHUNK_SIZE
+#define ECS_ARCHETYPE_CHUNK_SIZE 16384
+#endif  // ECS_ARCHETYPE_CHUNK_SIZE
+
 // Validate configuration macros
 #if !((ECS_ENTITY_CONFIG) == 8 || (ECS_ENTITY_CONFIG) == 16 || \
       (ECS_ENTITY_CONFIG) == 32 || (ECS_ENTITY_CONFIG) == 64)
 #error "ECS_ENTITY_CONFIG must be 8, 16, 32, or 64"
 #endif
 
+#if (ECS_ENTITY_GENERATION_BITS) < 0 || \
+    (ECS_ENTITY_GENERATION_BITS) >= (ECS_ENTITY_CONFIG)
+#error "ECS_ENTITY_GENERATION_BITS must be in [0, ECS_ENTITY_CONFIG)"
+#endif
+
 #if !((ECS_COMPONENT_CONFIG) == 8 || (ECS_COMPONENT_CONFIG) == 16 || \
       (ECS_COMPONENT_CONFIG) == 32)
 #error "ECS_COMPONENT_CONFIG must be 8, 16, or 32"
@@ -84,6 +129,15 @@ namespace ecs {
 #error "ECS_MAX_COMPONENT_TYPES must be greater than 0"
 #endif
 
+#if (ECS_SPARSE_PAGE_SIZE) <= 0 || \
+    ((ECS_SPARSE_PAGE_SIZE) & ((ECS_SPARSE_PAGE_SIZE) - 1)) != 0
+#error "ECS_SPARSE_PAGE_SIZE must be a power of two"
+#endif
+
+#if (ECS_ARCHETYPE_CHUNK_SIZE) <= 0
+#error "ECS_ARCHETYPE_CHUNK_SIZE must be greater than 0"
+#endif
+
 #if ECS_ENTITY_CONFIG == 64
 /// @brief Entity identifier type (configured for 64-bit).
 using Entity = std::uint64_t;
@@ -111,6 +165,21 @@ using ComponentTypeId = std::uint8_t;
 
 constexpr size_t kMaxComponentTypes = ECS_MAX_COMPONENT_TYPES;
 
+constexpr size_t kEntityGenerationBits = ECS_ENTITY_GENERATION_BITS;
+
+constexpr size_t kEntityIndexBits = ECS_ENTITY_CONFIG - kEntityGenerationBits;
+
+/// @brief Upper bound (exclusive) of entity IDs, limited by the bits left
+/// next to the generation in an EntityHandle.
+constexpr Entity kMaxEntities =
+    kEntityGenerationBits == 0
+        ? std::numeric_limits<Entity>::max()
+        : static_cast<Entity>((Entity{1} << kEntityIndexBits) - 1);
+
+constexpr size_t kSparsePageSize = ECS_SPARSE_PAGE_SIZE;
+
+constexpr size_t kArchetypeChunkSize = ECS_ARCHETYPE_CHUNK_SIZE;
+
 // Validate ECS_MAX_COMPONENT_TYPES at compile time
 static_assert(ECS_MAX_COMPONENT_TYPES > 0,
               "ECS_MAX_COMPONENT_TYPES must be greater than 0");
@@ -119,7 +188,81 @@ static_assert(ECS_MAX_COMPONENT_TYPES <= 65536,
 
 /// @brief Bitset representing which component types are associated with an
 /// entity.
-using Signature = std::bitset<kMaxComponentTypes>;
+using Signature = BasicSignature<kMaxComponentTypes>;
+
+/**
+ * @class EntityHandle
+ * @brief Versioned reference to an entity that detects ID reuse.
+ *
+ * @details
+ * Packs an entity ID and the generation of that ID into one Entity sized
+ * value: the ID in the low kEntityIndexBits bits, the generation above them.
+ * The generation of an ID is bumped every time it is destroyed, so a handle
+ * kept past the entity's destruction no longer matches, even after the ID
+ * has been recycled. Generations wrap around after 2^kEntityGenerationBits
+ * destructions of the same ID.
+ *
+ * Handles are obtained from EntityManager::GetHandle() and checked with
+ * EntityManager::IsAlive().
+ */
+class EntityHandle {
+ public:
+  /// @brief Mask of the entity ID bits.
+  static constexpr Entity kIndexMask = kEntityGenerationBits == 0
+                                           ? std::numeric_limits<Entity>::max()
+                                           : kMaxEntities;
+
+  /// @brief Mask of a generation, before it is shifted into place.
+  static constexpr Entity kGenerationMask =
+      kEntityGenerationBits == 0
+          ? 0
+          : static_cast<Entity>(std::numeric_limits<Entity>::max() >>
+                                kEntityIndexBits);
+
+  /// @brief Constructs a handle that never refers to a living entity.
+  constexpr EntityHandle() = default;
+
+  /**
+   * @brief Constructs a handle from an entity ID and its generation.
+   *
+   * @param entity The entity ID. Must be below kMaxEntities.
+   * @param generation The generation, truncated to kEntityGenerationBits.
+   */
+  constexpr EntityHandle(Entity entity, Entity generation)
+      : value_(static_cast<Entity>((entity & kIndexMask) |
+                                   shift_generation(generation))) {}
+
+  /// @brief Returns the entity ID.
+  constexpr Entity get_entity() const {
+    return static_cast<Entity>(value_ & kIndexMask);
+  }
+
+  /// @brief Returns the generation of the entity ID the handle refers to.
+  constexpr Entity get_generation() const {
+    if constexpr (kEntityGenerationBits == 0) {
+      return 0;
+    } else {
+      return static_cast<Entity>(value_ >> kEntityIndexBits);
+    }
+  }
+
+  /// @brief Returns the packed ID and generation, e.g. for serialization.
+  constexpr Entity get_value() const { return value_; }
+
+  friend constexpr bool operator==(EntityHandle, EntityHandle) = default;
+
+ private:
+  Entity value_ = std::numeric_limits<Entity>::max();
+
+  static constexpr Entity shift_generation(Entity generation) {
+    if constexpr (kEntityGenerationBits == 0) {
+      return 0;
+    } else {
+      return static_cast<Entity>((generation & kGenerationMask)
+                                 << kEntityIndexBits);
+    }
+  }
+};
 
 }  // namespace ECS
 
@@ -1,22 +1,48 @@
 #include "src/ecs/coordinator/coordinator.h"
 
+#include <absl/log/check.h>
 #include <absl/log/log.h>
 
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
 #include "src/ecs/component/component.h"
 #include "src/ecs/component_manager/component_manager.h"
 #include "src/ecs/context/context.h"
 #include "src/ecs/entity_manager/entity_manager.h"
+#include "src/ecs/memory/memory.h"
 #include "src/ecs/system_manager/system_manager.h"
 
 namespace ecs {
 
 // #####   Constructors   #####
-Coordinator::Coordinator() { Init(); }
+Coordinator::Coordinator(StorageMode storage_mode,
+                         std::pmr::memory_resource* resource)
+    : resource_(resource) {
+  Init(storage_mode);
+}
 
 // #####   Entity methods   #####
-Entity Coordinator::CreateEntity() { return entity_manager_->CreateEntity(); }
+Entity Coordinator::CreateEntity() {
+  check_structural_change("create an entity");
+  return entity_manager_->CreateEntity();
+}
+
+std::vector<Entity> Coordinator::CreateEntities(size_t count) {
+  check_structural_change("create entities");
+  return entity_manager_->CreateEntities(count);
+}
+
+Coordinator& Coordinator::CreateEntities(std::span<Entity> entities) {
+  check_structural_change("create entities");
+  entity_manager_->CreateEntities(entities);
+  return *this;
+}
 
 Coordinator& Coordinator::DestroyEntity(Entity entity) {
+  check_structural_change("destroy an entity");
   entity_manager_->DestroyEntity(entity);
   component_manager_->EntityDestroyed(entity);
   system_manager_->EntityDestroyed(entity);
@@ -24,12 +50,32 @@ Coordinator& Coordinator::DestroyEntity(Entity entity) {
   return *this;
 }
 
-Signature Coordinator::GetEntitySignature(Entity entity) {
+EntityHandle Coordinator::GetHandle(Entity entity) {
+  return entity_manager_->GetHandle(entity);
+}
+
+Coordinator& Coordinator::set_recycle_order(RecycleOrder recycle_order) {
+  entity_manager_->set_recycle_order(recycle_order);
+  return *this;
+}
+
+const Signature& Coordinator::GetEntitySignature(Entity entity) const {
   return entity_manager_->GetSignature(entity);
 }
 
+Coordinator& Coordinator::Compact() {
+  check_structural_change("compact the pools");
+  component_manager_->Compact();
+  return *this;
+}
+
+Coordinator& Coordinator::set_shrink_policy(ShrinkPolicy policy) {
+  component_manager_->set_shrink_policy(policy);
+  return *this;
+}
+
 // #####   Private methods   #####
-Coordinator& Coordinator::Init() {
+Coordinator& Coordinator::Init(StorageMode storage_mode) {
 // Write a warning message when in debug mode about the limitations of the
 // system and how to configure it
 #ifndef NDEBUG
@@ -37,12 +83,32 @@ Coordinator& Coordinator::Init() {
 #endif
 
   // Create pointers to each manager
-  component_manager_ = std::make_unique<ComponentManager>();
-  entity_manager_ = std::make_unique<EntityManager>();
-  system_manager_ = std::make_unique<SystemManager>();
+  component_manager_ =
+      MakeResourcePtr<ComponentManager>(resource_, storage_mode, resource_);
+  entity_manager_ = MakeResourcePtr<EntityManager>(resource_, resource_);
+  system_manager_ = MakeResourcePtr<SystemManager>(resource_, resource_);
   return *this;
 }
 
+Coordinator& Coordinator::component_changed(Entity entity,
+                                            ComponentTypeId component_type,
+                                            bool added) {
+  entity_manager_->SetSignatureBit(entity, component_type, added);
+
+  // Pass a copy, as systems may create entities when the entity enters or
+  // leaves them, which reallocates the signatures
+  Signature signature = entity_manager_->GetSignature(entity);
+  system_manager_->EntitySignatureChanged(entity, signature, component_type);
+
+  return *this;
+}
+
+void Coordinator::check_structural_change(const char* change) const {
+  CHECK(!in_parallel_each_)
+      << "Attempted to " << change << " during ParallelEach. Record the "
+      << "change in the CommandBuffer passed to the function instead.";
+}
+
 #ifndef NDEBUG
 void Coordinator::debug_warning() {
   LOG(INFO)
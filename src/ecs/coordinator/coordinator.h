@@ -11,14 +11,28 @@
 #ifndef TBGE_ECS_COORDINATOR_H_
 #define TBGE_ECS_COORDINATOR_H_
 
+#include <cstddef>
 #include <memory>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <vector>
 
 #include "src/ecs/component_manager/component_manager.h"
 #include "src/ecs/entity_manager/entity_manager.h"
+#include "src/ecs/memory/memory.h"
 #include "src/ecs/system_manager/system_manager.h"
 
+namespace tbge {
+namespace jobs {
+class JobSystem;
+}  // namespace jobs
+}  // namespace tbge
+
 namespace ecs {
 
+class CommandBuffer;
+
 /**
  * @class Coordinator
  * @brief Central class for managing entities, components, and systems in
@@ -38,8 +52,19 @@ class Coordinator {
    * @details
    * The constructor calls the Init() method to set up the necessary components
    * and systems required for the Coordinator to function properly.
+   *
+   * @param storage_mode How component data is stored. Per-type
+   * ComponentArrays by default, or archetype chunks shared by all entities
+   * with the same Signature.
+   * @param resource The memory resource every internal container and manager
+   * of this Coordinator allocates from. Must outlive the Coordinator and the
+   * systems it returns. Building each short-lived world on its own
+   * std::pmr::monotonic_buffer_resource or pool resource keeps worlds from
+   * fragmenting the global heap and releases a world's memory at once.
    */
-  Coordinator();
+  explicit Coordinator(
+      StorageMode storage_mode = StorageMode::kComponentArrays,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
   // #####   Entity methods   #####
   /**
@@ -49,6 +74,27 @@ class Coordinator {
    */
   Entity CreateEntity();
 
+  /**
+   * @brief Creates many entities at once.
+   *
+   * @details
+   * Recycled IDs are used first, the rest are fresh consecutive IDs. Meant for
+   * loading worlds, together with AddComponents().
+   *
+   * @param count The number of entities to create.
+   * @return The identifiers of the new entities.
+   */
+  std::vector<Entity> CreateEntities(size_t count);
+
+  /**
+   * @brief Creates one entity for each element of entities and stores its
+   * identifier there, without allocating the result.
+   *
+   * @param entities Receives the identifiers of the new entities.
+   * @return Reference to the Coordinator for method chaining.
+   */
+  Coordinator& CreateEntities(std::span<Entity> entities);
+
   /**
    * @brief Destroys the specified entity and removes all associated components.
    *
@@ -63,6 +109,55 @@ class Coordinator {
    */
   Coordinator& DestroyEntity(Entity entity);
 
+  /**
+   * @brief Returns a versioned handle to a living entity.
+   *
+   * @details
+   * Unlike an Entity, a handle notices when its entity is destroyed, even if
+   * the ID has been reused since. Hold handles in scripts and other long-lived
+   * state and resolve them with GetEntity() when needed.
+   *
+   * @param entity The entity to refer to. Must exist.
+   * @return The handle.
+   */
+  EntityHandle GetHandle(Entity entity);
+
+  /**
+   * @brief Checks in O(1) whether the entity of a handle still exists.
+   *
+   * @param handle The handle to check.
+   * @return true if the entity has not been destroyed.
+   */
+  bool IsAlive(EntityHandle handle) const {
+    return entity_manager_->IsAlive(handle);
+  }
+
+  /**
+   * @brief Returns the entity a handle refers to.
+   *
+   * @note Only debug builds check that the handle is alive, release builds
+   * just unpack the ID. Call IsAlive() first when the entity may be gone.
+   *
+   * @param handle The handle to resolve.
+   * @return The entity ID.
+   */
+  Entity GetEntity(EntityHandle handle) const {
+    return entity_manager_->GetEntity(handle);
+  }
+
+  /**
+   * @brief Sets the order in which destroyed entity IDs are reused.
+   *
+   * @details
+   * RecycleOrder::kLifo and RecycleOrder::kLowestFirst keep new entities near
+   * recently used or low IDs, which packs entity-indexed arrays more tightly
+   * than the default RecycleOrder::kFifo.
+   *
+   * @param recycle_order The new order.
+   * @return Reference to the Coordinator for method chaining.
+   */
+  Coordinator& set_recycle_order(RecycleOrder recycle_order);
+
   // #####   Component methods   #####
   /**
    * @brief Registers a new component type with the coordinator.
@@ -72,6 +167,9 @@ class Coordinator {
    * component type that will be used in the ECS (Entity Component System). It
    * typically sets up internal data structures to manage the component type.
    *
+   * Empty types (see TagComponent) get no storage at all. Adding or removing
+   * them only flips their bit in the entity's Signature.
+   *
    * @tparam T The type of the component to register.
    * @return Reference to the Coordinator instance for method chaining.
    */
@@ -92,6 +190,64 @@ class Coordinator {
   template <typename T>
   Coordinator& AddComponent(Entity entity, T component);
 
+  /**
+   * @brief Constructs a component of type T in place for the specified entity.
+   *
+   * @details
+   * Like AddComponent(), but forwards args to the constructor of T so the
+   * component is built directly in its storage without an intermediate copy.
+   *
+   * @tparam T The type of the component to construct.
+   * @tparam Args The constructor argument types of T.
+   * @param entity The entity to which the component will be added.
+   * @param args The arguments forwarded to the constructor of T.
+   * @return Reference to the Coordinator for method chaining.
+   */
+  template <typename T, typename... Args>
+  Coordinator& EmplaceComponent(Entity entity, Args&&... args);
+
+  /**
+   * @brief Adds one component of each type Ts to each of many entities.
+   *
+   * @details
+   * Reserves storage once per type, updates all signatures in one pass and
+   * notifies the systems once for the whole batch, instead of once per
+   * AddComponent() call.
+   *
+   * Example:
+   * @code
+   *   std::vector<ecs::Entity> rooms = coordinator.CreateEntities(3);
+   *   coordinator.AddComponents<Position, Description>(rooms, positions,
+   *                                                    descriptions);
+   * @endcode
+   *
+   * @tparam Ts The types of the components to add.
+   * @param entities The entities the components are added to.
+   * @param components For each type, one component per entity in the same
+   * order as entities.
+   * @return Reference to the Coordinator for method chaining.
+   */
+  template <typename... Ts>
+  Coordinator& AddComponents(
+      std::span<const Entity> entities,
+      std::type_identity_t<std::span<const Ts>>... components);
+
+  /**
+   * @brief Adds a copy of one prototype of each type Ts to each of many
+   * entities.
+   *
+   * @details
+   * Like the span overload, but every entity receives the same values.
+   *
+   * @tparam Ts The types of the components to add.
+   * @param entities The entities the components are added to.
+   * @param prototypes The components copied to every entity.
+   * @return Reference to the Coordinator for method chaining.
+   */
+  template <typename... Ts>
+  Coordinator& AddComponents(std::span<const Entity> entities,
+                             const std::type_identity_t<Ts>&... prototypes);
+
   /**
    * @brief Removes a component of type T from the specified entity.
    *
@@ -122,12 +278,13 @@ class Coordinator {
    * @tparam T The type of the component to retrieve.
    * @param entity The entity whose component is to be retrieved.
    * @return Reference to the component of type T associated with the specified
-   * entity.
+   * entity. Components that specialize SoaTraits are returned as a
+   * SoaReference<T> proxy, and tags by value.
    *
    * @note Will abort if the entity does not have a component of type T.
    */
   template <typename T>
-  T& GetComponent(Entity entity);
+  ComponentReference<T> GetComponent(Entity entity);
 
   /**
    * @brief Retrieves the unique ComponentTypeId identifier for the specified
@@ -141,6 +298,179 @@ class Coordinator {
   template <typename T>
   ComponentTypeId GetComponentTypeId();
 
+  /**
+   * @brief Calls func(entity, components...) for every entity that has all of
+   * the component types Ts.
+   *
+   * @details
+   * With StorageMode::kArchetypes this is a linear scan over the chunks of
+   * every archetype that contains Ts.
+   *
+   * Tags in Ts filter the visited entities by their signatures and are passed
+   * to func by value. At least one of Ts must not be a tag.
+   *
+   * @note func must not add or remove components or destroy entities.
+   *
+   * @tparam Ts The component types to visit.
+   * @tparam Func Callable taking (Entity, ComponentReference<Ts>...).
+   * @param func The function to call for every matching entity.
+   * @return Reference to the Coordinator for method chaining.
+   */
+  template <typename... Ts, typename Func>
+  Coordinator& Each(Func&& func);
+
+  /**
+   * @brief Returns a View over every entity that has all component types Ts.
+   *
+   * @details
+   * The view iterates the smallest of the participating component arrays and
+   * checks the others in O(1) per entity. Iterate it with a range-based for
+   * loop and structured bindings, or call each() with a lambda. Tags in Ts
+   * filter the entities through their signatures.
+   *
+   * @code
+   *   for (auto [entity, position, velocity] :
+   *        coordinator.View<Position, Velocity>()) {
+   *     position.x += velocity.dx;
+   *   }
+   * @endcode
+   *
+   * @note Only available with StorageMode::kComponentArrays. Each() visits
+   * the same entities in both storage modes.
+   *
+   * @tparam Ts The distinct component types to view.
+   * @return A view over the components of types Ts.
+   */
+  template <typename... Ts>
+  ecs::View<Ts...> View();
+
+  /**
+   * @brief Returns the owning group of component types Ts, creating it on the
+   * first call.
+   *
+   * @details
+   * A group keeps the entities that have every type in Ts packed at the front
+   * of each of their ComponentArrays, in the same order. Iterating it is a
+   * linear walk over contiguous arrays without lookups, at the cost of a few
+   * swaps whenever one of the components is added or removed.
+   *
+   * @note Each component type can be owned by at most one group. Only
+   * available with StorageMode::kComponentArrays.
+   *
+   * @tparam Ts The component types owned by the group.
+   * @return Reference to the group, owned by the Coordinator.
+   */
+  template <typename... Ts>
+  ecs::Group<Ts...>& Group();
+
+  /**
+   * @brief Returns the pool holding every component of type T.
+   *
+   * @details
+   * The pool is owned by the Coordinator and stays at the same address for its
+   * whole lifetime. Systems can look it up once, e.g. when they are set up,
+   * and then call HasData() and GetData() on it directly, which skips the
+   * component type lookup of HasComponent() and GetComponent().
+   *
+   * @note Accessing a pool directly does not update entity signatures or
+   * notify systems. Use it for reading and modifying components; add and
+   * remove them through the Coordinator.
+   *
+   * @note Only available with StorageMode::kComponentArrays.
+   *
+   * @tparam T The component type.
+   * @return Reference to the ComponentArray of type T.
+   */
+  template <typename T>
+  ComponentArray<T>& GetPool();
+
+  /**
+   * @brief Returns a view over the field columns of a component type stored as
+   * a structure of arrays.
+   *
+   * @details
+   * Each field listed in SoaTraits<T>::kFields is exposed as a contiguous
+   * span, for loops that only need some of the fields.
+   *
+   * @note Only available with StorageMode::kComponentArrays.
+   *
+   * @tparam T A component type that specializes SoaTraits.
+   * @return A view over the components of type T.
+   */
+  template <SoaComponent T>
+  SoaView<T> GetSoaView();
+
+  /**
+   * @brief Sorts the pool of a component type in place.
+   *
+   * @details
+   * Afterwards View, Each and the pool iterate the components in the order
+   * given by compare. Sorting e.g. by the entity a component refers to keeps
+   * the data a system reads together next to each other in memory. Pools that
+   * are re-sorted every frame stay almost sorted, so SortStrategy::kInsertion
+   * keeps the cost low.
+   *
+   * @note Only available with StorageMode::kComponentArrays. Aborts if the
+   * pool is owned by a group.
+   *
+   * @tparam T The component type.
+   * @tparam Compare Strict weak ordering called with two components.
+   * @param compare Returns true if the first component goes before the second.
+   * @param strategy The sorting algorithm to use.
+   * @return Reference to the current Coordinator for method chaining.
+   */
+  template <typename T, typename Compare>
+  Coordinator& Sort(Compare compare,
+                    SortStrategy strategy = SortStrategy::kFull);
+
+  /**
+   * @brief Sorts the pool of a component type by ascending entity ID.
+   *
+   * @note Only available with StorageMode::kComponentArrays. Aborts if the
+   * pool is owned by a group.
+   *
+   * @tparam T The component type.
+   * @param strategy The sorting algorithm to use.
+   * @return Reference to the current Coordinator for method chaining.
+   */
+  template <typename T>
+  Coordinator& SortByEntity(SortStrategy strategy = SortStrategy::kFull);
+
+  /**
+   * @brief Releases the unused capacity of the pool of a component type.
+   *
+   * @note Only available with StorageMode::kComponentArrays.
+   *
+   * @tparam T The component type.
+   * @return Reference to the current Coordinator for method chaining.
+   */
+  template <typename T>
+  Coordinator& ShrinkToFit();
+
+  /**
+   * @brief Releases the unused capacity of every component pool.
+   *
+   * @details
+   * Removed components are destroyed right away, but pools keep their
+   * capacity so that refilling them does not reallocate. Call this after
+   * removing many components, e.g. when a level is unloaded.
+   *
+   * @return Reference to the current Coordinator for method chaining.
+   */
+  Coordinator& Compact();
+
+  /**
+   * @brief Sets when every component pool releases unused capacity on its
+   * own, including pools of component types registered later.
+   *
+   * @details
+   * The policy of a single pool can be overridden through GetPool().
+   *
+   * @param policy The policy the pools check after every removal.
+   * @return Reference to the current Coordinator for method chaining.
+   */
+  Coordinator& set_shrink_policy(ShrinkPolicy policy);
+
   // #####   System methods   #####
   /**
    * @brief Registers a new system of type T with the coordinator.
@@ -197,6 +527,35 @@ class Coordinator {
   template <typename T>
   Signature GetSystemSignature();
 
+  /**
+   * @brief Sets the component types an entity must not have to be processed
+   * by the system of type T.
+   *
+   * Example:
+   * @code
+   *   ecs::Signature hidden;
+   *   hidden.set(coordinator.GetComponentTypeId<Hidden>());
+   *   coordinator.SetSystemExcludedSignature<RenderSystem>(hidden);
+   * @endcode
+   *
+   * @tparam T The type of the system.
+   * @param excluded The component types to exclude.
+   * @return Reference to the Coordinator to allow method chaining.
+   */
+  template <typename T>
+  Coordinator& SetSystemExcludedSignature(Signature excluded);
+
+  /**
+   * @brief Sets the component types the system of type T reads when an
+   * entity has them, without requiring them.
+   *
+   * @tparam T The type of the system.
+   * @param optional The optional component types.
+   * @return Reference to the Coordinator to allow method chaining.
+   */
+  template <typename T>
+  Coordinator& SetSystemOptionalSignature(Signature optional);
+
   /**
    * @brief Retrieves the component signature of an entity.
    *
@@ -205,9 +564,10 @@ class Coordinator {
    * represents the set of components attached to that entity.
    *
    * @param entity The entity whose signature is to be retrieved.
-   * @return The signature representing the components attached to the entity.
+   * @return A const reference to the signature representing the components
+   * attached to the entity.
    */
-  Signature GetEntitySignature(Entity entity);
+  const Signature& GetEntitySignature(Entity entity) const;
 
   /**
    * @brief Determines if an entity is valid for a system of type T.
@@ -215,7 +575,7 @@ class Coordinator {
    * @details
    * Checks whether the entity's signature matches the signature required by
    * the system of type T. Returns true if the entity has all the components
-   * the system requires.
+   * the system requires and none of the components it excludes.
    *
    * @tparam T The type of the system to check compatibility with.
    * @param entity The entity to validate.
@@ -234,10 +594,31 @@ class Coordinator {
   /// @brief Returns a pointer to the system manager instance.
   SystemManager* get_system_manager() { return system_manager_.get(); }
 
+  /// @brief Returns how component data is stored.
+  StorageMode get_storage_mode() const {
+    return component_manager_->get_storage_mode();
+  }
+
+  /// @brief Returns the memory resource the Coordinator allocates from.
+  std::pmr::memory_resource* get_memory_resource() const { return resource_; }
+
  private:
-  std::unique_ptr<ComponentManager> component_manager_;
-  std::unique_ptr<EntityManager> entity_manager_;
-  std::unique_ptr<SystemManager> system_manager_;
+  /// Applies batches of deferred component additions
+  friend class CommandBuffer;
+
+  /// Forbids structural changes while it runs
+  template <typename... Ts, typename Func>
+  friend Coordinator& ParallelEach(Coordinator& coordinator,
+                                   tbge::jobs::JobSystem& job_system,
+                                   Func&& func, size_t grain_size);
+
+  std::pmr::memory_resource* resource_;
+  ResourcePtr<ComponentManager> component_manager_;
+  ResourcePtr<EntityManager> entity_manager_;
+  ResourcePtr<SystemManager> system_manager_;
+
+  /// Whether a ParallelEach() is running, which forbids structural changes
+  bool in_parallel_each_ = false;
 
   /**
    * @brief Initializes the Coordinator instance.
@@ -249,9 +630,52 @@ class Coordinator {
    *
    * @note This function is automatically called by the constructor.
    *
+   * @param storage_mode How component data is stored.
    * @return Reference to the initialized Coordinator instance.
    */
-  Coordinator& Init();
+  Coordinator& Init(StorageMode storage_mode);
+
+  /**
+   * @brief Updates the signatures of entities that were given components of
+   * types Ts, and notifies the systems once for all of them.
+   *
+   * @tparam Ts The component types that were added.
+   * @param entities The entities the components were added to.
+   * @return Reference to the Coordinator for method chaining.
+   */
+  template <typename... Ts>
+  Coordinator& components_added(std::span<const Entity> entities);
+
+  /**
+   * @brief Removes the components of type T from entities, clears their
+   * signature bits and notifies the systems once for all of them.
+   *
+   * @tparam T The component type to remove.
+   * @param entities The entities to remove the component from.
+   * @return Reference to the Coordinator for method chaining.
+   */
+  template <typename T>
+  Coordinator& components_removed(std::span<const Entity> entities);
+
+  /**
+   * @brief Sets or clears the bit of one component type in an entity's
+   * signature and notifies the systems.
+   *
+   * @param entity The entity whose component changed.
+   * @param component_type The component type that was added or removed.
+   * @param added Whether the component was added.
+   * @return Reference to the Coordinator for method chaining.
+   */
+  Coordinator& component_changed(Entity entity, ComponentTypeId component_type,
+                                 bool added);
+
+  /// @brief Returns the ComponentArray of T, or a TagFilter if T is a tag, to
+  /// build a View from.
+  template <typename T>
+  decltype(auto) view_pool();
+
+  /// @brief Aborts if a ParallelEach() is running.
+  void check_structural_change(const char* change) const;
 
 #ifndef NDEBUG
   void debug_warning();
@@ -1,9 +1,18 @@
 #ifndef TBGE_ECS_COORDINATOR_TCC_
 #define TBGE_ECS_COORDINATOR_TCC_
 
+#include <absl/log/check.h>
+
+#include <memory_resource>
+#include <span>
+#include <tuple>
 #include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
 #include "src/ecs/component/component.h"
+#include "src/ecs/component/tag.h"
 #include "src/ecs/component_manager/component_manager.h"
 #include "src/ecs/context/context.h"
 #include "src/ecs/coordinator/coordinator.h"
@@ -21,45 +30,159 @@ Coordinator& Coordinator::RegisterComponentType() {
 
 template <typename T>
 Coordinator& Coordinator::AddComponent(Entity entity, T component) {
+  check_structural_change("add a component");
+
   // If the component inherits from Component, automatically set its entity ID
   if constexpr (std::is_base_of_v<Component, T>) {
     component.set_entity_id(entity);
   }
 
-  component_manager_->template AddComponent<T>(entity, component);
+  component_manager_->template AddComponent<T>(entity, std::move(component));
 
-  Signature signature = entity_manager_->GetSignature(entity);
-  signature.set(component_manager_->template GetComponentTypeId<T>(), true);
-  entity_manager_->SetSignature(entity, signature);
+  return component_changed(
+      entity, component_manager_->template GetComponentTypeId<T>(), true);
+}
 
-  system_manager_->EntitySignatureChanged(entity, signature);
+template <typename T, typename... Args>
+Coordinator& Coordinator::EmplaceComponent(Entity entity, Args&&... args) {
+  check_structural_change("add a component");
+  component_manager_->template EmplaceComponent<T>(
+      entity, std::forward<Args>(args)...);
 
-  return *this;
+  // If the component inherits from Component, automatically set its entity ID
+  if constexpr (std::is_base_of_v<Component, T> && !SoaComponent<T>) {
+    component_manager_->template GetComponent<T>(entity).set_entity_id(entity);
+  }
+
+  return component_changed(
+      entity, component_manager_->template GetComponentTypeId<T>(), true);
+}
+
+template <typename... Ts>
+Coordinator& Coordinator::AddComponents(
+    std::span<const Entity> entities,
+    std::type_identity_t<std::span<const Ts>>... components) {
+  check_structural_change("add components");
+  (component_manager_->template AddComponents<Ts>(entities, components), ...);
+
+  return components_added<Ts...>(entities);
+}
+
+template <typename... Ts>
+Coordinator& Coordinator::AddComponents(
+    std::span<const Entity> entities,
+    const std::type_identity_t<Ts>&... prototypes) {
+  check_structural_change("add components");
+  (component_manager_->template AddComponents<Ts>(entities, prototypes), ...);
+
+  return components_added<Ts...>(entities);
 }
 
 template <typename T>
 Coordinator& Coordinator::RemoveComponent(Entity entity) {
+  check_structural_change("remove a component");
   component_manager_->template RemoveComponent<T>(entity);
 
-  // Grabbing the signature of the entity, resetting the bit corresponding to
-  // the component, and setting the signature of the entity to the new one.
-  Signature signature = entity_manager_->GetSignature(entity);
-  signature.set(component_manager_->template GetComponentTypeId<T>(), false);
-  entity_manager_->SetSignature(entity, signature);
+  return component_changed(
+      entity, component_manager_->template GetComponentTypeId<T>(), false);
+}
+
+template <typename T>
+ComponentReference<T> Coordinator::GetComponent(Entity entity) {
+  if constexpr (TagComponent<T>) {
+    CHECK(HasComponent<T>(entity))
+        << "Retrieving non-existent component of type '" << typeid(T).name()
+        << "'.";
+    return T{};
+  } else {
+    return component_manager_->template GetComponent<T>(entity);
+  }
+}
+
+template <typename T>
+ComponentTypeId Coordinator::GetComponentTypeId() {
+  return component_manager_->template GetComponentTypeId<T>();
+}
 
-  system_manager_->EntitySignatureChanged(entity, signature);
+template <typename... Ts, typename Func>
+Coordinator& Coordinator::Each(Func&& func) {
+  if constexpr ((!TagComponent<Ts> && ...)) {
+    component_manager_->template Each<Ts...>(std::forward<Func>(func));
+  } else if (get_storage_mode() == StorageMode::kComponentArrays) {
+    View<Ts...>().each(std::forward<Func>(func));
+  } else {
+    Signature tags;
+    (
+        [&] {
+          if constexpr (TagComponent<Ts>) {
+            tags.set(GetComponentTypeId<Ts>(), true);
+          }
+        }(),
+        ...);
+
+    // Visit the stored types and filter by the tags in the signatures
+    const std::pmr::vector<Signature>& signatures =
+        entity_manager_->get_signatures();
+    [&]<typename... Ds>(std::tuple<Ds...>*) {
+      component_manager_->template Each<Ds...>(
+          [&](Entity entity, ComponentReference<Ds>... components) {
+            if (!signatures[entity].includes(tags)) {
+              return;
+            }
+            std::tuple<ComponentReference<Ds>...> stored(components...);
+            func(entity, [&stored]() -> ComponentReference<Ts> {
+              if constexpr (TagComponent<Ts>) {
+                return Ts{};
+              } else {
+                return std::get<ComponentReference<Ts>>(stored);
+              }
+            }()...);
+          });
+    }(static_cast<tag_internal::WithoutTags<Ts...>*>(nullptr));
+  }
 
   return *this;
 }
 
+template <typename... Ts>
+ecs::View<Ts...> Coordinator::View() {
+  return ecs::View<Ts...>(view_pool<Ts>()...);
+}
+
+template <typename... Ts>
+ecs::Group<Ts...>& Coordinator::Group() {
+  return component_manager_->template GetGroup<Ts...>();
+}
+
 template <typename T>
-T& Coordinator::GetComponent(Entity entity) {
-  return component_manager_->template GetComponent<T>(entity);
+ComponentArray<T>& Coordinator::GetPool() {
+  return component_manager_->template GetPool<T>();
+}
+
+template <SoaComponent T>
+SoaView<T> Coordinator::GetSoaView() {
+  return component_manager_->template GetSoaView<T>();
+}
+
+template <typename T, typename Compare>
+Coordinator& Coordinator::Sort(Compare compare, SortStrategy strategy) {
+  check_structural_change("sort a pool");
+  component_manager_->template GetPool<T>().Sort(std::move(compare), strategy);
+  return *this;
 }
 
 template <typename T>
-ComponentTypeId Coordinator::GetComponentTypeId() {
-  return component_manager_->template GetComponentTypeId<T>();
+Coordinator& Coordinator::SortByEntity(SortStrategy strategy) {
+  check_structural_change("sort a pool");
+  component_manager_->template GetPool<T>().SortByEntity(strategy);
+  return *this;
+}
+
+template <typename T>
+Coordinator& Coordinator::ShrinkToFit() {
+  check_structural_change("shrink a pool");
+  component_manager_->template GetPool<T>().ShrinkToFit();
+  return *this;
 }
 
 // #####   System methods   #####
@@ -70,7 +193,11 @@ std::shared_ptr<T> Coordinator::RegisterSystem() {
 
 template <typename T>
 bool Coordinator::HasComponent(Entity entity) {
-  return component_manager_->HasComponent<T>(entity);
+  if constexpr (TagComponent<T>) {
+    return entity_manager_->GetSignature(entity).test(GetComponentTypeId<T>());
+  } else {
+    return component_manager_->HasComponent<T>(entity);
+  }
 }
 
 template <typename T>
@@ -89,11 +216,89 @@ Signature Coordinator::GetSystemSignature() {
   return system_manager_->template GetSignature<T>();
 }
 
+template <typename T>
+Coordinator& Coordinator::SetSystemExcludedSignature(Signature excluded) {
+  system_manager_->template SetExcludedSignature<T>(excluded);
+  return *this;
+}
+
+template <typename T>
+Coordinator& Coordinator::SetSystemOptionalSignature(Signature optional) {
+  system_manager_->template SetOptionalSignature<T>(optional);
+  return *this;
+}
+
 template <typename T>
 bool Coordinator::EntityIsValidForSystem(Entity entity) {
-  auto system_signature = GetSystemSignature<T>();
-  auto entity_signature = GetEntitySignature(entity);
-  return (system_signature & entity_signature) == system_signature;
+  const Signature& entity_signature = GetEntitySignature(entity);
+  return entity_signature.includes(GetSystemSignature<T>()) &&
+         !entity_signature.intersects(
+             system_manager_->template GetExcludedSignature<T>());
+}
+
+// #####   Private methods   #####
+template <typename... Ts>
+Coordinator& Coordinator::components_added(std::span<const Entity> entities) {
+  // If a component inherits from Component, automatically set its entity ID
+  (
+      [&] {
+        if constexpr (std::is_base_of_v<Component, Ts> && !SoaComponent<Ts>) {
+          for (Entity entity : entities) {
+            component_manager_->template GetComponent<Ts>(entity)
+                .set_entity_id(entity);
+          }
+        }
+      }(),
+      ...);
+
+  const ComponentTypeId component_types[] = {
+      component_manager_->template GetComponentTypeId<Ts>()...};
+
+  std::pmr::vector<Signature> signatures(resource_);
+  signatures.reserve(entities.size());
+  for (Entity entity : entities) {
+    for (ComponentTypeId component_type : component_types) {
+      entity_manager_->SetSignatureBit(entity, component_type, true);
+    }
+    signatures.push_back(entity_manager_->GetSignature(entity));
+  }
+
+  system_manager_->EntitiesSignatureChanged(entities, signatures,
+                                            component_types);
+
+  return *this;
+}
+
+template <typename T>
+Coordinator& Coordinator::components_removed(std::span<const Entity> entities) {
+  for (Entity entity : entities) {
+    component_manager_->template RemoveComponent<T>(entity);
+  }
+
+  const ComponentTypeId component_types[] = {
+      component_manager_->template GetComponentTypeId<T>()};
+
+  std::pmr::vector<Signature> signatures(resource_);
+  signatures.reserve(entities.size());
+  for (Entity entity : entities) {
+    entity_manager_->SetSignatureBit(entity, component_types[0], false);
+    signatures.push_back(entity_manager_->GetSignature(entity));
+  }
+
+  system_manager_->EntitiesSignatureChanged(entities, signatures,
+                                            component_types);
+
+  return *this;
+}
+
+template <typename T>
+decltype(auto) Coordinator::view_pool() {
+  if constexpr (TagComponent<T>) {
+    return TagFilter<T>(entity_manager_->get_signatures(),
+                        GetComponentTypeId<T>());
+  } else {
+    return (component_manager_->template GetPool<T>());
+  }
 }
 
 }  // namespace ECS
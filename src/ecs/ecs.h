@@ -19,14 +19,26 @@
 #ifndef TBGE_ECS_ECS_H_
 #define TBGE_ECS_ECS_H_
 
+#include "src/ecs/archetype/archetype.h"
+#include "src/ecs/archetype/archetype_storage.h"
+#include "src/ecs/command_buffer/command_buffer.h"
 #include "src/ecs/component/component.h"
+#include "src/ecs/component/soa.h"
+#include "src/ecs/component/tag.h"
 #include "src/ecs/component_array/component_array.h"
+#include "src/ecs/component_array/soa_view.h"
 #include "src/ecs/component_manager/component_manager.h"
 #include "src/ecs/context/context.h"
 #include "src/ecs/coordinator/coordinator.h"
 #include "src/ecs/entity_manager/entity_manager.h"
+#include "src/ecs/group/group.h"
+#include "src/ecs/memory/memory.h"
+#include "src/ecs/scheduler/scheduler.h"
+#include "src/ecs/sparse_index/sparse_index.h"
 #include "src/ecs/system/system.h"
 #include "src/ecs/system_manager/system_manager.h"
+#include "src/ecs/type_index/type_index.h"
 #include "src/ecs/utils/setup_console.h"
+#include "src/ecs/view/view.h"
 
 #endif  // TBGE_ECS_ECS_H_
\ No newline at end of file
@@ -3,38 +3,83 @@
 #include <absl/log/check.h>
 #include <absl/log/log.h>
 
-#include <limits>
-#include <queue>
+#include <algorithm>
+#include <functional>
+#include <span>
 #include <vector>
 
 #include "src/ecs/context/context.h"
 
 namespace ecs {
 
+namespace {
+
+constexpr char kEntityLimitHint[] =
+    ". To increase this limit, define ECS_ENTITY_CONFIG to a larger value "
+    "(8, 16, 32, or 64 bits) or ECS_ENTITY_GENERATION_BITS to a smaller one "
+    "before including ECS headers for the first time.";
+
+}  // namespace
+
 Entity EntityManager::CreateEntity() {
+  Entity id = pop_free();
+
   // If there are no available entities, create one
-  if (available_entities_.empty()) {
-    CHECK(entity_id_counter_ < std::numeric_limits<Entity>::max())
+  if (id == kNoEntity) {
+    CHECK(entity_id_counter_ < kMaxEntities)
         << "Too many Entities were created. The maximum amount of Entities is "
-        << std::numeric_limits<Entity>::max()
-        << ". To increase this limit, define ECS_ENTITY_CONFIG to a larger "
-           "value "
-        << "(8, 16, 32, or 64 bits) before including ECS headers for the first "
-           "time.";
+        << kMaxEntities << kEntityLimitHint;
 
-    available_entities_.push(entity_id_counter_);
+    id = entity_id_counter_++;
     signatures_.push_back(Signature());
-    ++entity_id_counter_;
+    slots_.push_back(EntitySlot());
+    alive_.push_back(false);
   }
 
-  // Take an ID from the front of the queue
-  Entity id = available_entities_.front();
-  available_entities_.pop();
+  alive_[id] = true;
   ++current_entity_count_;
 
   return id;
 }
 
+std::vector<Entity> EntityManager::CreateEntities(size_t count) {
+  std::vector<Entity> entities(count);
+  CreateEntities(entities);
+
+  return entities;
+}
+
+EntityManager& EntityManager::CreateEntities(std::span<Entity> entities) {
+  // Hand out recycled IDs first
+  size_t recycled_count = 0;
+  while (recycled_count < entities.size()) {
+    Entity id = pop_free();
+    if (id == kNoEntity) {
+      break;
+    }
+    alive_[id] = true;
+    ++current_entity_count_;
+    entities[recycled_count++] = id;
+  }
+
+  size_t fresh_count = entities.size() - recycled_count;
+  CHECK(fresh_count <= static_cast<size_t>(kMaxEntities - entity_id_counter_))
+      << "Too many Entities were created. The maximum amount of Entities is "
+      << kMaxEntities << kEntityLimitHint;
+
+  // Grow the per-ID arrays once for all fresh IDs
+  signatures_.resize(signatures_.size() + fresh_count);
+  slots_.resize(slots_.size() + fresh_count);
+  alive_.resize(alive_.size() + fresh_count, true);
+  for (size_t i = recycled_count; i < entities.size(); ++i) {
+    entities[i] = entity_id_counter_++;
+  }
+
+  current_entity_count_ += static_cast<Entity>(fresh_count);
+
+  return *this;
+}
+
 EntityManager& EntityManager::DestroyEntity(Entity entity) {
 #ifndef NDEBUG
   if (entity >= entity_id_counter_) {
@@ -47,36 +92,39 @@ EntityManager& EntityManager::DestroyEntity(Entity entity) {
   }
 #endif
 
-  // Invalidate the destroyed entity's signature
+  if (!alive_.at(entity)) {
+    LOG(ERROR) << "Attempted to destroy Entity ID " << entity
+               << " more than once.";
+    return *this;
+  }
+
+  // Invalidate the destroyed entity's signature and handles
   signatures_.at(entity).reset();
+  EntitySlot& slot = slots_[entity];
+  slot.generation = static_cast<Entity>((slot.generation + 1) &
+                                        EntityHandle::kGenerationMask);
+  alive_[entity] = false;
 
-  // Put the destroyed ID at the back of the queue
-  available_entities_.push(entity);
+  push_free(entity);
   --current_entity_count_;
 
   return *this;
 }
 
-bool EntityManager::HasEntity(Entity entity) {
-  if (entity > entity_id_counter_) {
-    return false;
-  }
-
-  bool has_entity = true;
+bool EntityManager::HasEntity(Entity entity) const {
+  return entity < entity_id_counter_ && alive_[entity];
+}
 
-  for (size_t i = 0; i < available_entities_.size(); ++i) {
-    if (available_entities_.front() == entity) {
-      // If the entity is in the queue it does not currently exist
-      has_entity = false;
-    }
-    available_entities_.push(available_entities_.front());
-    available_entities_.pop();
-  }
+EntityHandle EntityManager::GetHandle(Entity entity) const {
+  CHECK(HasEntity(entity))
+      << "Attempted to get a handle to a non-existent Entity at Entity ID "
+      << entity << ".";
 
-  return has_entity;
+  return EntityHandle(entity, slots_[entity].generation);
 }
 
-EntityManager& EntityManager::SetSignature(Entity entity, Signature signature) {
+EntityManager& EntityManager::SetSignature(Entity entity,
+                                          const Signature& signature) {
 #ifndef NDEBUG
   if (entity >= entity_id_counter_) {
     LOG(ERROR)
@@ -95,7 +143,27 @@ EntityManager& EntityManager::SetSignature(Entity entity, Signature signature) {
   return *this;
 }
 
-Signature EntityManager::GetSignature(Entity entity) {
+EntityManager& EntityManager::SetSignatureBit(Entity entity,
+                                             ComponentTypeId component_type,
+                                             bool value) {
+#ifndef NDEBUG
+  if (entity >= entity_id_counter_) {
+    LOG(ERROR)
+        << "Attempted to set signature of Entity out of range at Entity ID "
+        << entity << ". The current amount of Entities is "
+        << entity_id_counter_
+        << ". This error usually means that you're trying to access an "
+           "Entity that has not yet been created or has been deleted.";
+    return *this;
+  }
+#endif
+
+  signatures_.at(entity).set(component_type, value);
+
+  return *this;
+}
+
+const Signature& EntityManager::GetSignature(Entity entity) const {
   CHECK(entity < entity_id_counter_)
       << "Attempted to get signature of Entity out of range at Entity ID "
       << entity << ". The current amount of Entities is " << entity_id_counter_
@@ -106,4 +174,83 @@ Signature EntityManager::GetSignature(Entity entity) {
   return signatures_.at(entity);
 }
 
+EntityManager& EntityManager::set_recycle_order(RecycleOrder recycle_order) {
+  recycle_order_ = recycle_order;
+
+  // Rebuild the free IDs so that they are handed out in ID order
+  free_head_ = kNoEntity;
+  free_tail_ = kNoEntity;
+  free_heap_.clear();
+  if (recycle_order_ == RecycleOrder::kLowestFirst) {
+    // Ascending IDs already form a min-heap
+    for (Entity entity = 0; entity < entity_id_counter_; ++entity) {
+      if (!alive_[entity]) {
+        free_heap_.push_back(entity);
+      }
+    }
+    return *this;
+  }
+
+  for (Entity entity = entity_id_counter_; entity-- > 0;) {
+    if (!alive_[entity]) {
+      slots_[entity].next_free = free_head_;
+      free_head_ = entity;
+      if (free_tail_ == kNoEntity) {
+        free_tail_ = entity;
+      }
+    }
+  }
+
+  return *this;
+}
+
+// #########################
+// #        PRIVATE        #
+// #########################
+Entity EntityManager::pop_free() {
+  if (current_entity_count_ == entity_id_counter_) {
+    return kNoEntity;
+  }
+
+  if (recycle_order_ == RecycleOrder::kLowestFirst) {
+    std::pop_heap(free_heap_.begin(), free_heap_.end(), std::greater<>());
+    Entity entity = free_heap_.back();
+    free_heap_.pop_back();
+    return entity;
+  }
+
+  Entity entity = free_head_;
+  free_head_ = slots_[entity].next_free;
+  if (free_head_ == kNoEntity) {
+    free_tail_ = kNoEntity;
+  }
+
+  return entity;
+}
+
+void EntityManager::push_free(Entity entity) {
+  switch (recycle_order_) {
+    case RecycleOrder::kFifo:
+      slots_[entity].next_free = kNoEntity;
+      if (free_tail_ == kNoEntity) {
+        free_head_ = entity;
+      } else {
+        slots_[free_tail_].next_free = entity;
+      }
+      free_tail_ = entity;
+      break;
+    case RecycleOrder::kLifo:
+      slots_[entity].next_free = free_head_;
+      if (free_head_ == kNoEntity) {
+        free_tail_ = entity;
+      }
+      free_head_ = entity;
+      break;
+    case RecycleOrder::kLowestFirst:
+      free_heap_.push_back(entity);
+      std::push_heap(free_heap_.begin(), free_heap_.end(), std::greater<>());
+      break;
+  }
+}
+
 }  // namespace ecs
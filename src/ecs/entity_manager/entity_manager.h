@@ -10,12 +10,30 @@
 #ifndef TBGE_ECS_ENTITY_MANAGER_H_
 #define TBGE_ECS_ENTITY_MANAGER_H_
 
-#include <queue>
+#include <absl/log/check.h>
+
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <span>
 #include <vector>
 
 #include "src/ecs/context/context.h"
 
 namespace ecs {
+/**
+ * @brief The order in which an EntityManager reuses destroyed entity IDs.
+ */
+enum class RecycleOrder {
+  /// Oldest destroyed ID first. Spreads new entities over the whole ID range.
+  kFifo,
+  /// Most recently destroyed ID first, whose slots are likely still cached.
+  kLifo,
+  /// Lowest free ID first, which keeps the living IDs in a dense range.
+  /// Creating and destroying entities costs O(log n) in the free IDs.
+  kLowestFirst,
+};
+
 /**
  * @class EntityManager
  * @brief Manages creation, destruction, and signature assignment of entities in
@@ -27,6 +45,8 @@ namespace ecs {
  * - Tracking the number of active entities.
  * - Managing entity signatures, which represent the set of components
  * associated with each entity.
+ * - Tracking the generation of every entity ID, so that EntityHandles to
+ * destroyed entities can be detected in O(1).
  *
  * Usage:
  * - Use CreateEntity() to obtain a new entity ID.
@@ -34,18 +54,36 @@ namespace ecs {
  * - Use SetSignature() and GetSignature() to manage the component signature of
  * an entity.
  *
+ * Free IDs are kept in a list threaded through the per-ID slot array, so
+ * recycling an ID allocates nothing. RecycleOrder::kLowestFirst keeps them in
+ * a min-heap instead, so recycling costs O(log n) in the number of free IDs.
+ * The RecycleOrder decides which free ID CreateEntity() hands out next.
+ *
  * @note The maximum number of entities is limited by kMaxEntities.
- * @note Entity IDs are recycled after destruction.
+ * @note Entity IDs are recycled after destruction. Code that keeps an entity
+ * across frames should keep an EntityHandle instead.
  */
 class EntityManager {
  public:
-  EntityManager() = default;
+  /**
+   * @brief Constructs an EntityManager without any entities.
+   *
+   * @param resource The memory resource for the per-ID arrays. Must outlive
+   * the manager.
+   */
+  explicit EntityManager(
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : signatures_(resource),
+        slots_(resource),
+        alive_(resource),
+        free_heap_(resource) {}
+
   /**
    * @brief Creates a new entity and returns its unique identifier.
    *
    * @details
-   * It retrieves an available entity ID from the front of the queue, increments
-   * the current entity count, and returns the new entity ID.
+   * Reuses a free ID, picked according to the RecycleOrder, if there is one.
+   * Otherwise a fresh ID is issued. The current entity count is incremented.
    *
    * @return Entity The unique identifier for the newly created entity.
    * @throws Assertion failure if the maximum number of entities is exceeded.
@@ -54,6 +92,32 @@ class EntityManager {
    */
   Entity CreateEntity();
 
+  /**
+   * @brief Creates count entities at once.
+   *
+   * @details
+   * Recycled IDs are handed out first, in the order CreateEntity() would use
+   * them. The remaining IDs are fresh and consecutive, and the signature
+   * array grows once for all of them.
+   *
+   * @param count The number of entities to create.
+   * @return The IDs of the new entities.
+   *
+   * @note Asserts that the maximum number of entities is not exceeded.
+   */
+  std::vector<Entity> CreateEntities(size_t count);
+
+  /**
+   * @brief Creates one entity for each element of entities and stores its ID
+   * there, without allocating the result.
+   *
+   * @param entities Receives the IDs of the new entities.
+   * @return Reference to the EntityManager for method chaining.
+   *
+   * @note Asserts that the maximum number of entities is not exceeded.
+   */
+  EntityManager& CreateEntities(std::span<Entity> entities);
+
   /**
    * @brief Destroys the specified entity and recycles its ID.
    *
@@ -63,6 +127,9 @@ class EntityManager {
    * back into the pool of available entities for future reuse. The total count
    * of active entities is decremented accordingly.
    *
+   * The generation of the ID is bumped, which invalidates every EntityHandle
+   * to the destroyed entity.
+   *
    * @param entity The entity to be destroyed. Must be within the valid range.
    * @return Reference to the current EntityManager instance for method
    * chaining.
@@ -74,16 +141,54 @@ class EntityManager {
   /**
    * @brief Checks if the specified entity exists in the manager.
    *
-   * @note This operation gets really expensive the more destroyed entities
-   * exist that has not yet been reused as it bases itself on which entities are
-   * currently in the available_entities_ queue, and as such has to go through
-   * the whole queue to verify if it is in use or not.
-   * This is mostly meant to be a debug tool.
-   *
    * @param entity The entity to check for existence.
    * @return true if the entity exists, false otherwise.
    */
-  bool HasEntity(Entity entity);
+  bool HasEntity(Entity entity) const;
+
+  /**
+   * @brief Returns a versioned handle to a living entity.
+   *
+   * @note Will abort if the entity does not exist.
+   *
+   * @param entity The entity to refer to.
+   * @return A handle holding the entity ID and its current generation.
+   */
+  EntityHandle GetHandle(Entity entity) const;
+
+  /**
+   * @brief Checks whether the entity a handle refers to still exists.
+   *
+   * @details
+   * A single generation compare. A handle stays alive until its entity is
+   * destroyed, even if the ID is later reused for a new entity.
+   *
+   * @param handle The handle to check.
+   * @return true if the handle's entity has not been destroyed.
+   */
+  bool IsAlive(EntityHandle handle) const {
+    Entity entity = handle.get_entity();
+    return entity < slots_.size() &&
+           slots_[entity].generation == handle.get_generation() &&
+           alive_[entity];
+  }
+
+  /**
+   * @brief Returns the entity a handle refers to.
+   *
+   * @details
+   * Debug builds abort if the handle is stale. Release builds skip the check
+   * and only unpack the ID, so resolving handles is free there.
+   *
+   * @param handle The handle to resolve.
+   * @return The entity ID stored in the handle.
+   */
+  Entity GetEntity(EntityHandle handle) const {
+    DCHECK(IsAlive(handle)) << "Resolving a stale handle to Entity ID "
+                            << handle.get_entity() << ". The Entity was "
+                            << "destroyed after the handle was taken.";
+    return handle.get_entity();
+  }
 
   /**
    * @brief Sets the signature for a given entity.
@@ -99,7 +204,22 @@ class EntityManager {
    *
    * @note Asserts that the entity is within the valid range.
    */
-  EntityManager& SetSignature(Entity entity, Signature signature);
+  EntityManager& SetSignature(Entity entity, const Signature& signature);
+
+  /**
+   * @brief Sets or clears the bit of one component type in an entity's
+   * signature, in place.
+   *
+   * @param entity The entity whose signature is to be changed.
+   * @param component_type The component type whose bit is changed.
+   * @param value Whether the entity has the component afterwards.
+   * @return Reference to the current EntityManager instance for method
+   * chaining.
+   *
+   * @note Asserts that the entity is within the valid range.
+   */
+  EntityManager& SetSignatureBit(Entity entity, ComponentTypeId component_type,
+                                 bool value);
 
   /**
    * @brief Retrieves the signature associated with a given entity.
@@ -108,12 +228,13 @@ class EntityManager {
    * represents the set of components that the entity possesses.
    *
    * @param entity The entity whose signature is to be retrieved.
-   * @return Signature The signature corresponding to the given entity.
+   * @return A const reference to the signature of the entity, valid until the
+   * next entity is created.
    * @throws Assertion failure if the entity is out of range.
    *
    * @note Asserts that the entity identifier is within the valid range.
    */
-  Signature GetSignature(Entity entity);
+  const Signature& GetSignature(Entity entity) const;
 
   /**
    * @brief Returns the total number of active entities.
@@ -129,18 +250,75 @@ class EntityManager {
    */
   Entity get_entity_id_counter() { return entity_id_counter_; }
 
+  /**
+   * @brief Returns the signature of every entity ID issued so far.
+   *
+   * @return A const reference to the signatures, indexed by entity ID.
+   * Unused IDs have an empty signature.
+   */
+  const std::pmr::vector<Signature>& get_signatures() const {
+    return signatures_;
+  }
+
+  /// @brief Returns the order in which destroyed IDs are reused.
+  RecycleOrder get_recycle_order() const { return recycle_order_; }
+
+  /**
+   * @brief Sets the order in which destroyed IDs are reused.
+   *
+   * @details
+   * IDs that are already free are reordered by ID, as their destruction order
+   * is not kept.
+   *
+   * @param recycle_order The new order.
+   * @return Reference to the current EntityManager instance for method
+   * chaining.
+   */
+  EntityManager& set_recycle_order(RecycleOrder recycle_order);
+
  private:
-  /// Queue of unused entity IDs
-  std::queue<Entity> available_entities_{};
+  /// Marks the end of the free list
+  static constexpr Entity kNoEntity = std::numeric_limits<Entity>::max();
+
+  /// @brief Bookkeeping of one entity ID.
+  struct EntitySlot {
+    /// Current generation of the ID, bumped when the ID is destroyed
+    Entity generation = 0;
+
+    /// Next ID in the free list while this ID is free
+    Entity next_free = kNoEntity;
+  };
 
   /// Array of signatures where the index corresponds to the entity ID
-  std::vector<Signature> signatures_{};
+  std::pmr::vector<Signature> signatures_;
+
+  /// Slot of each entity ID, which also hold the free list
+  std::pmr::vector<EntitySlot> slots_;
+
+  /// Whether each entity ID is in use
+  std::pmr::vector<bool> alive_;
+
+  /// First and last ID of the free list. Unused with kLowestFirst.
+  Entity free_head_ = kNoEntity;
+  Entity free_tail_ = kNoEntity;
+
+  /// Min-heap of the free IDs. Only used with kLowestFirst.
+  std::pmr::vector<Entity> free_heap_;
+
+  RecycleOrder recycle_order_ = RecycleOrder::kFifo;
 
   /// Total living entities - used to keep limits on how many exist
   Entity current_entity_count_ = 0;
 
   /// Keeps track of the next Entity ID to be used when creating a new one.
   Entity entity_id_counter_ = 0;
+
+  /// @brief Takes a free ID according to the RecycleOrder, or returns
+  /// kNoEntity if there is none.
+  Entity pop_free();
+
+  /// @brief Returns a destroyed ID to the free IDs.
+  void push_free(Entity entity);
 };
 }  // namespace ECS
 
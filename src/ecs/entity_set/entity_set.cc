@@ -0,0 +1,78 @@
+#include "src/ecs/entity_set/entity_set.h"
+
+#include <cstddef>
+#include <utility>
+
+#include "src/ecs/context/context.h"
+
+namespace ecs {
+
+EntitySet::EntitySet(const EntitySet& other) : EntitySet() { *this = other; }
+
+EntitySet& EntitySet::operator=(const EntitySet& other) {
+  if (this == &other) {
+    return *this;
+  }
+
+  clear();
+  dense_.reserve(other.size());
+  for (Entity entity : other) {
+    insert(entity);
+  }
+
+  return *this;
+}
+
+std::pair<EntitySet::iterator, bool> EntitySet::insert(Entity entity) {
+  Entity index = sparse_.Get(entity);
+  if (index != SparseIndex::kInvalidIndex) {
+    return {dense_.begin() + index, false};
+  }
+
+  sparse_.Set(entity, static_cast<Entity>(dense_.size()));
+  dense_.push_back(entity);
+
+  return {dense_.end() - 1, true};
+}
+
+size_t EntitySet::erase(Entity entity) {
+  Entity index = sparse_.Get(entity);
+  if (index == SparseIndex::kInvalidIndex) {
+    return 0;
+  }
+
+  // Fill the gap with the last entity to keep the array packed
+  Entity last = dense_.back();
+  dense_[index] = last;
+  sparse_.Set(last, index);
+  dense_.pop_back();
+  sparse_.Erase(entity);
+
+  return 1;
+}
+
+EntitySet::iterator EntitySet::erase(const_iterator position) {
+  size_t index = static_cast<size_t>(position - dense_.begin());
+  erase(*position);
+
+  // The last entity now fills the slot, or the slot was the last one
+  return dense_.begin() + index;
+}
+
+EntitySet::const_iterator EntitySet::find(Entity entity) const {
+  Entity index = sparse_.Get(entity);
+  if (index == SparseIndex::kInvalidIndex) {
+    return dense_.end();
+  }
+
+  return dense_.begin() + index;
+}
+
+EntitySet& EntitySet::clear() {
+  dense_.clear();
+  sparse_.Clear();
+
+  return *this;
+}
+
+}  // namespace ecs
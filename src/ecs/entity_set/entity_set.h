@@ -0,0 +1,155 @@
+/**
+ * @file entity_set.h
+ * @brief Sparse set of entities with contiguous iteration.
+ *
+ * @details
+ * Used by systems to track the entities matching their signature.
+ */
+
+#ifndef TBGE_ECS_ENTITY_SET_H_
+#define TBGE_ECS_ENTITY_SET_H_
+
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "src/ecs/context/context.h"
+#include "src/ecs/sparse_index/sparse_index.h"
+
+namespace ecs {
+
+/**
+ * @class EntitySet
+ * @brief Set of entities stored as a packed array and a SparseIndex.
+ *
+ * @details
+ * Insertion, erasure and lookups are O(1) and never allocate per entity.
+ * Iteration walks a contiguous array. Erasing moves the last entity into the
+ * freed slot, so the iteration order is unspecified and changes when entities
+ * are erased.
+ *
+ * The interface follows std::set where it overlaps, so code written against
+ * the std::set<Entity> that systems used before keeps compiling: insert()
+ * returns an iterator and a bool, find(), count() and contains() look
+ * entities up, and erase() takes an entity or an iterator. The iterators are
+ * random access, which is a superset of the bidirectional iterators of
+ * std::set, but they do not visit the entities in ascending order.
+ *
+ * @note Inserting or erasing invalidates iterators. Record changes made while
+ * iterating in a CommandBuffer instead.
+ */
+class EntitySet {
+ public:
+  using value_type = Entity;
+  using size_type = size_t;
+  using const_iterator = std::pmr::vector<Entity>::const_iterator;
+  using iterator = const_iterator;
+
+  /**
+   * @brief Constructs an empty EntitySet.
+   *
+   * @param resource The memory resource the packed array and the index are
+   * allocated from. Must outlive the set.
+   */
+  explicit EntitySet(
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : dense_(resource), sparse_(resource) {}
+
+  /// @brief Copies the entities onto the default memory resource, like the
+  /// copy constructors of std::pmr containers.
+  EntitySet(const EntitySet& other);
+
+  /// @brief Replaces the entities, keeping this set's memory resource.
+  EntitySet& operator=(const EntitySet& other);
+
+  EntitySet(EntitySet&&) = default;
+  EntitySet& operator=(EntitySet&&) = default;
+
+  /**
+   * @brief Adds an entity to the set.
+   *
+   * @param entity The entity to add.
+   * @return An iterator to the entity, and true if the entity was added or
+   * false if it already was in the set.
+   */
+  std::pair<iterator, bool> insert(Entity entity);
+
+  /**
+   * @brief Removes an entity from the set.
+   *
+   * @details
+   * Moves the last entity of the packed array into the freed slot.
+   *
+   * @param entity The entity to remove.
+   * @return The number of removed entities, 0 or 1.
+   */
+  size_t erase(Entity entity);
+
+  /**
+   * @brief Removes the entity an iterator points to.
+   *
+   * @details
+   * Moves the last entity of the packed array into the freed slot, which the
+   * returned iterator points to. Loops of the form `it = set.erase(it)`
+   * therefore still visit every entity.
+   *
+   * @param position Iterator to the entity to remove. Must be dereferenceable.
+   * @return An iterator to the entity following the removed one.
+   */
+  iterator erase(const_iterator position);
+
+  /**
+   * @brief Removes every entity from the set.
+   *
+   * @return Reference to this EntitySet for method chaining.
+   */
+  EntitySet& clear();
+
+  /**
+   * @brief Checks whether the set contains an entity.
+   *
+   * @param entity The entity to look up.
+   * @return true if the entity is in the set; false otherwise.
+   */
+  bool contains(Entity entity) const { return sparse_.Contains(entity); }
+
+  /**
+   * @brief Looks up an entity.
+   *
+   * @param entity The entity to look up.
+   * @return An iterator to the entity, or end() if it is not in the set.
+   */
+  const_iterator find(Entity entity) const;
+
+  /// @brief Returns 1 if the set contains the entity, 0 otherwise.
+  size_t count(Entity entity) const { return contains(entity) ? 1 : 0; }
+
+  /// @brief Returns the number of entities in the set.
+  size_t size() const { return dense_.size(); }
+
+  /// @brief Checks whether the set is empty.
+  bool empty() const { return dense_.empty(); }
+
+  const_iterator begin() const { return dense_.begin(); }
+  const_iterator end() const { return dense_.end(); }
+
+  /**
+   * @brief Returns the packed array of entities.
+   *
+   * @return A view of the entities in iteration order.
+   */
+  std::span<const Entity> get_entities() const { return dense_; }
+
+ private:
+  /// @brief The entities in the set, without gaps.
+  std::pmr::vector<Entity> dense_;
+
+  /// @brief Maps an entity to its position in dense_.
+  SparseIndex sparse_;
+};
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_ENTITY_SET_H_
@@ -0,0 +1,115 @@
+/**
+ * @file group.h
+ * @brief Owning groups that keep several component arrays ordered in lockstep.
+ */
+
+#ifndef TBGE_ECS_GROUP_H_
+#define TBGE_ECS_GROUP_H_
+
+#include <cstddef>
+#include <span>
+#include <tuple>
+
+#include "src/ecs/component_array/component_array.h"
+#include "src/ecs/context/context.h"
+
+namespace ecs {
+
+/**
+ * @class Group
+ * @brief Owns the ComponentArrays of Ts and keeps the entities that have all of
+ * them packed at the front of each array, in the same order.
+ *
+ * @details
+ * Index i below get_size() holds the same entity in every owned array, so
+ * iterating the group is a parallel linear walk over contiguous storage with
+ * no sparse lookups. The arrays notify the group through GenericGroup when a
+ * component is inserted or removed, and the group swaps entries to keep the
+ * front range exact.
+ *
+ * Each ComponentArray can be owned by at most one group.
+ *
+ * @code
+ *   auto& movers = coordinator.Group<Position, Velocity>();
+ *   movers.each([](ecs::Entity, Position& position, Velocity& velocity) {
+ *     position.x += velocity.dx;
+ *   });
+ * @endcode
+ *
+ * @note Components must not be added or removed, and entities must not be
+ * destroyed, while a group is being iterated.
+ *
+ * @tparam Ts The distinct component types owned by the group.
+ */
+template <typename... Ts>
+class Group : public GenericGroup {
+  static_assert(sizeof...(Ts) > 1,
+                "A Group needs at least two component types.");
+  static_assert((!TagComponent<Ts> && ...),
+                "Tag components have no storage for a Group to own.");
+
+ public:
+  /**
+   * @brief Takes ownership of the ordering of the given arrays and groups the
+   * entities that already have every component.
+   *
+   * @note Aborts if one of the arrays is already owned by another group.
+   *
+   * @param component_arrays One ComponentArray per component type. They must
+   * outlive the group.
+   */
+  explicit Group(ComponentArray<Ts>&... component_arrays);
+
+  /**
+   * @brief Releases the owned arrays.
+   */
+  ~Group() override;
+
+  Group(const Group&) = delete;
+  Group& operator=(const Group&) = delete;
+
+  /**
+   * @brief Calls func(entity, components...) for every entity in the group.
+   *
+   * @tparam Func Callable taking (Entity, ComponentReference<Ts>...).
+   * @param func The function to call for every entity in the group.
+   * @return Reference to the current Group for method chaining.
+   */
+  template <typename Func>
+  const Group& each(Func&& func) const;
+
+  /**
+   * @brief Checks whether an entity is part of the group.
+   *
+   * @param entity The entity to check.
+   * @return true if the entity has every component type Ts; false otherwise.
+   */
+  bool Contains(Entity entity) const;
+
+  /// @brief Adds the entity to the group if it now has every component type.
+  void ComponentAdded(Entity entity) override;
+
+  /// @brief Removes the entity from the group if it is part of it.
+  void ComponentRemoving(Entity entity) override;
+
+  /// @brief Returns the number of entities in the group.
+  size_t get_size() const { return size_; }
+
+  /// @brief Returns the entities in the group, in packed order.
+  std::span<const Entity> get_entities() const {
+    return {std::get<0>(component_arrays_)->get_entities().data(), size_};
+  }
+
+ private:
+  /// @brief The owned component arrays.
+  std::tuple<ComponentArray<Ts>*...> component_arrays_;
+
+  /// @brief Number of entities packed at the front of every owned array.
+  size_t size_ = 0;
+};
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_GROUP_H_
+
+#include "src/ecs/group/group.tcc"
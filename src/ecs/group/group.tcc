@@ -0,0 +1,106 @@
+#ifndef TBGE_ECS_GROUP_TCC_
+#define TBGE_ECS_GROUP_TCC_
+
+#include <absl/log/check.h>
+
+#include <cstddef>
+#include <tuple>
+#include <typeinfo>
+#include <vector>
+
+#include "src/ecs/component_array/component_array.h"
+#include "src/ecs/context/context.h"
+#include "src/ecs/group/group.h"
+
+namespace ecs {
+
+template <typename... Ts>
+Group<Ts...>::Group(ComponentArray<Ts>&... component_arrays)
+    : component_arrays_(&component_arrays...) {
+  (
+      [&] {
+        CHECK(component_arrays.get_group() == nullptr)
+            << "Component type '" << typeid(Ts).name()
+            << "' is already owned by another group.";
+        component_arrays.set_group(this);
+      }(),
+      ...);
+
+  // Group the entities that already have every component. Copy the entities
+  // first, as grouping reorders the arrays.
+  const std::pmr::vector<Entity>& owned_entities =
+      std::get<0>(component_arrays_)->get_entities();
+  std::pmr::vector<Entity> entities(owned_entities,
+                                    owned_entities.get_allocator());
+  for (Entity entity : entities) {
+    ComponentAdded(entity);
+  }
+}
+
+template <typename... Ts>
+Group<Ts...>::~Group() {
+  std::apply(
+      [](auto*... component_arrays) {
+        (component_arrays->set_group(nullptr), ...);
+      },
+      component_arrays_);
+}
+
+template <typename... Ts>
+template <typename Func>
+const Group<Ts...>& Group<Ts...>::each(Func&& func) const {
+  const std::pmr::vector<Entity>& entities =
+      std::get<0>(component_arrays_)->get_entities();
+  auto storages = std::make_tuple(
+      &std::get<ComponentArray<Ts>*>(component_arrays_)->get_storage()...);
+
+  // Index i holds the same entity in every owned array
+  for (size_t i = 0; i < size_; ++i) {
+    func(entities[i], std::get<ComponentStorage<Ts>*>(storages)->Get(i)...);
+  }
+
+  return *this;
+}
+
+template <typename... Ts>
+bool Group<Ts...>::Contains(Entity entity) const {
+  const auto* first = std::get<0>(component_arrays_);
+  return first->HasData(entity) && first->GetIndex(entity) < size_;
+}
+
+template <typename... Ts>
+void Group<Ts...>::ComponentAdded(Entity entity) {
+  bool complete =
+      (std::get<ComponentArray<Ts>*>(component_arrays_)->HasData(entity) &&
+       ...);
+  if (!complete || Contains(entity)) {
+    return;
+  }
+
+  // Move the entity to the end of the grouped range in every array
+  (std::get<ComponentArray<Ts>*>(component_arrays_)
+       ->SwapEntries(std::get<ComponentArray<Ts>*>(component_arrays_)
+                         ->GetIndex(entity),
+                     size_),
+   ...);
+  ++size_;
+}
+
+template <typename... Ts>
+void Group<Ts...>::ComponentRemoving(Entity entity) {
+  if (!Contains(entity)) {
+    return;
+  }
+
+  // Move the entity to the last slot of the grouped range and shrink it
+  --size_;
+  (std::get<ComponentArray<Ts>*>(component_arrays_)
+       ->SwapEntries(std::get<ComponentArray<Ts>*>(component_arrays_)
+                         ->GetIndex(entity),
+                     size_),
+   ...);
+}
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_GROUP_TCC_
@@ -0,0 +1,90 @@
+/**
+ * @file memory.h
+ * @brief Helpers for allocating ECS objects from a memory resource.
+ *
+ * @details
+ * Every container of a Coordinator allocates from the std::pmr::memory_resource
+ * the Coordinator was built with. Containers use the std::pmr aliases; single
+ * objects such as component pools are owned through ResourcePtr.
+ */
+
+#ifndef TBGE_ECS_MEMORY_H_
+#define TBGE_ECS_MEMORY_H_
+
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+namespace ecs {
+
+/**
+ * @brief Destroys an object and returns its memory to the resource it was
+ * allocated from.
+ *
+ * @details
+ * Remembers how the most derived type was allocated, so a ResourcePtr to a
+ * base class frees the right number of bytes.
+ *
+ * @tparam T The type of the owned pointer.
+ */
+template <typename T>
+class ResourceDeleter {
+ public:
+  /// @brief Function destroying and deallocating an object of the most
+  /// derived type through a pointer to T.
+  using DestroyFunction = void (*)(T*, std::pmr::memory_resource*);
+
+  ResourceDeleter() = default;
+
+  ResourceDeleter(std::pmr::memory_resource* resource, DestroyFunction destroy)
+      : resource_(resource), destroy_(destroy) {}
+
+  void operator()(T* object) const { destroy_(object, resource_); }
+
+  /// @brief Returns the resource the object was allocated from.
+  std::pmr::memory_resource* get_resource() const { return resource_; }
+
+ private:
+  std::pmr::memory_resource* resource_ = nullptr;
+  DestroyFunction destroy_ = nullptr;
+};
+
+/// @brief Owning pointer to an object allocated from a memory resource.
+template <typename T>
+using ResourcePtr = std::unique_ptr<T, ResourceDeleter<T>>;
+
+/**
+ * @brief Allocates and constructs a U from a memory resource.
+ *
+ * Example:
+ * @code
+ *   ResourcePtr<GenericComponentArray> pool =
+ *       MakeResourcePtr<ComponentArray<Position>, GenericComponentArray>(
+ *           resource, resource);
+ * @endcode
+ *
+ * @tparam U The type of the object to construct.
+ * @tparam T The type of the returned pointer, U or a base class of U.
+ * @param resource The resource the object is allocated from. Must outlive the
+ * object.
+ * @param args The arguments forwarded to the constructor of U.
+ * @return An owning pointer that frees the object back into resource.
+ */
+template <typename U, typename T = U, typename... Args>
+ResourcePtr<T> MakeResourcePtr(std::pmr::memory_resource* resource,
+                               Args&&... args) {
+  std::pmr::polymorphic_allocator<U> allocator(resource);
+  U* object = std::construct_at(allocator.allocate(1),
+                                std::forward<Args>(args)...);
+
+  auto destroy = [](T* base, std::pmr::memory_resource* resource) {
+    U* derived = static_cast<U*>(base);
+    std::destroy_at(derived);
+    std::pmr::polymorphic_allocator<U>(resource).deallocate(derived, 1);
+  };
+  return ResourcePtr<T>(object, ResourceDeleter<T>(resource, destroy));
+}
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_MEMORY_H_
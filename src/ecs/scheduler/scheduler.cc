@@ -0,0 +1,117 @@
+#include "src/ecs/scheduler/scheduler.h"
+
+#include <absl/log/check.h>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "src/jobs/job_system.h"
+
+namespace ecs {
+
+Scheduler::Scheduler(tbge::jobs::JobSystem& job_system,
+                     std::pmr::memory_resource* resource)
+    : systems_(resource), job_system_(&job_system) {}
+
+Scheduler::Scheduler(size_t worker_count, std::pmr::memory_resource* resource)
+    : systems_(resource),
+      owned_job_system_(
+          std::make_unique<tbge::jobs::JobSystem>(worker_count)),
+      job_system_(owned_job_system_.get()) {}
+
+Scheduler& Scheduler::Add(std::string_view name, SystemAccess access,
+                          std::function<void()> update) {
+  CHECK(update != nullptr) << "System \"" << name
+                           << "\" was added to a Scheduler without a function.";
+
+  size_t system = systems_.size();
+  systems_.push_back({std::pmr::string(name, systems_.get_allocator()), access,
+                      std::move(update),
+                      std::pmr::vector<size_t>(systems_.get_allocator())});
+
+  // Order the new system after every earlier system it conflicts with
+  for (size_t earlier = 0; earlier < system; ++earlier) {
+    if (systems_[earlier].access.ConflictsWith(access)) {
+      systems_[earlier].successors.push_back(system);
+      ++systems_[system].dependency_count;
+    }
+  }
+
+  // Make room for the counters of the next Run()
+  pending_dependencies_.reset();
+
+  return *this;
+}
+
+Scheduler& Scheduler::Run() {
+  if (systems_.empty()) {
+    return *this;
+  }
+
+  if (pending_dependencies_ == nullptr) {
+    pending_dependencies_ =
+        std::make_unique<std::atomic<size_t>[]>(systems_.size());
+  }
+  for (size_t system = 0; system < systems_.size(); ++system) {
+    pending_dependencies_[system].store(systems_[system].dependency_count,
+                                        std::memory_order_relaxed);
+  }
+
+  // Queue the systems without dependencies, the rest follow as they finish
+  tbge::jobs::TaskGroup group(*job_system_);
+  for (size_t system = 0; system < systems_.size(); ++system) {
+    if (systems_[system].dependency_count == 0) {
+      group.Run([this, system, &group] { run_system(system, group); });
+    }
+  }
+  group.Wait();
+
+  return *this;
+}
+
+std::string_view Scheduler::GetSystemName(size_t system) const {
+  CHECK(system < systems_.size())
+      << "Attempted to get the name of system " << system
+      << ", but the Scheduler only has " << systems_.size() << " systems.";
+
+  return systems_[system].name;
+}
+
+std::vector<size_t> Scheduler::GetDependencies(size_t system) const {
+  CHECK(system < systems_.size())
+      << "Attempted to get the dependencies of system " << system
+      << ", but the Scheduler only has " << systems_.size() << " systems.";
+
+  std::vector<size_t> dependencies;
+  for (size_t earlier = 0; earlier < system; ++earlier) {
+    for (size_t successor : systems_[earlier].successors) {
+      if (successor == system) {
+        dependencies.push_back(earlier);
+      }
+    }
+  }
+
+  return dependencies;
+}
+
+// #########################
+// #        PRIVATE        #
+// #########################
+void Scheduler::run_system(size_t system, tbge::jobs::TaskGroup& group) {
+  systems_[system].update();
+
+  for (size_t successor : systems_[system].successors) {
+    if (pending_dependencies_[successor].fetch_sub(
+            1, std::memory_order_acq_rel) == 1) {
+      group.Run([this, successor, &group] { run_system(successor, group); });
+    }
+  }
+}
+
+}  // namespace ecs
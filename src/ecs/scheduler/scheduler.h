@@ -0,0 +1,191 @@
+/**
+ * @file scheduler.h
+ * @brief Runs systems in parallel based on the components they access.
+ *
+ * @details
+ * Systems declare which component types they read and write. Systems whose
+ * accesses conflict run one after another in the order they were added, and
+ * all others run at the same time as tasks of a tbge::jobs::JobSystem.
+ */
+
+#ifndef TBGE_ECS_SCHEDULER_H_
+#define TBGE_ECS_SCHEDULER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "src/ecs/context/context.h"
+#include "src/jobs/job_system.h"
+
+namespace ecs {
+
+/**
+ * @brief The component types a system reads and writes while it runs.
+ */
+struct SystemAccess {
+  /// Component types the system only reads
+  Signature reads;
+
+  /// Component types the system modifies
+  Signature writes;
+
+  /// Whether the system must run alone, e.g. because it creates or destroys
+  /// entities or adds or removes components
+  bool exclusive = false;
+
+  /**
+   * @brief Checks whether two systems must not run at the same time.
+   *
+   * @details
+   * Two systems conflict if either is exclusive, or if one writes a component
+   * type the other reads or writes. Systems that only read the same types do
+   * not conflict.
+   *
+   * @param other The access of the other system.
+   * @return true if the systems conflict; false otherwise.
+   */
+  bool ConflictsWith(const SystemAccess& other) const {
+    return exclusive || other.exclusive || writes.intersects(other.writes) ||
+           writes.intersects(other.reads) || reads.intersects(other.writes);
+  }
+};
+
+/**
+ * @class Scheduler
+ * @brief Runs a list of systems once per call to Run(), in parallel where
+ * their declared accesses allow.
+ *
+ * @details
+ * Every system added to the scheduler depends on each earlier system it
+ * conflicts with. Run() queues the systems without pending dependencies as
+ * tasks, and queues the others as soon as their dependencies have finished.
+ * The calling thread runs systems too while it waits. Conflicting systems
+ * therefore always run in the order they were added, while the rest of the
+ * order is left to the threads.
+ *
+ * Example:
+ * @code
+ *   ecs::SystemAccess npc_access;
+ *   npc_access.reads.set(coordinator.GetComponentTypeId<Position>());
+ *   npc_access.writes.set(coordinator.GetComponentTypeId<Npc>());
+ *
+ *   ecs::Scheduler scheduler;
+ *   scheduler.Add("npc", npc_access, [&] { npc_system->Update(); })
+ *       .Add("economy", economy_access, [&] { economy_system->Update(); });
+ *   scheduler.Run();
+ * @endcode
+ *
+ * @note Systems running in parallel must only touch the component types they
+ * declared, and must not create or destroy entities or add or remove
+ * components. Record such changes in a CommandBuffer per system and flush
+ * them after Run(), or declare the system exclusive.
+ */
+class Scheduler {
+ public:
+  /**
+   * @brief Constructs a scheduler that runs systems on a shared JobSystem.
+   *
+   * @param job_system The JobSystem to run the systems on. Must outlive the
+   * scheduler.
+   * @param resource The memory resource the system list is allocated from.
+   * Must outlive the scheduler.
+   */
+  explicit Scheduler(
+      tbge::jobs::JobSystem& job_system,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  /**
+   * @brief Constructs a scheduler with its own JobSystem.
+   *
+   * @param worker_count The number of worker threads. The thread calling
+   * Run() runs systems as well, so 0 runs every system on that thread in the
+   * order they were added.
+   * @param resource The memory resource the system list is allocated from.
+   * Must outlive the scheduler.
+   */
+  explicit Scheduler(
+      size_t worker_count = tbge::jobs::JobSystem::default_worker_count(),
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  Scheduler(const Scheduler&) = delete;
+  Scheduler& operator=(const Scheduler&) = delete;
+
+  /**
+   * @brief Adds a system to run on every call to Run().
+   *
+   * @param name The name of the system, returned by GetSystemName(), e.g. to
+   * label the systems returned by GetDependencies().
+   * @param access The component types the system reads and writes.
+   * @param update The function running the system.
+   * @return Reference to this Scheduler for method chaining.
+   */
+  Scheduler& Add(std::string_view name, SystemAccess access,
+                 std::function<void()> update);
+
+  /**
+   * @brief Runs every system once and returns when all have finished.
+   *
+   * @return Reference to this Scheduler for method chaining.
+   *
+   * @note Must not be called from a system of the same scheduler.
+   */
+  Scheduler& Run();
+
+  /**
+   * @brief Returns the name a system was added with.
+   *
+   * @param system The position of the system in the order it was added.
+   * @return The name, valid until the scheduler is destroyed.
+   */
+  std::string_view GetSystemName(size_t system) const;
+
+  /**
+   * @brief Returns the systems a system waits for.
+   *
+   * @param system The position of the system in the order it was added.
+   * @return The positions of the earlier systems it conflicts with.
+   */
+  std::vector<size_t> GetDependencies(size_t system) const;
+
+  /// @brief Returns the number of added systems.
+  size_t get_system_count() const { return systems_.size(); }
+
+  /// @brief Returns the number of worker threads.
+  size_t get_worker_count() const { return job_system_->get_worker_count(); }
+
+ private:
+  struct ScheduledSystem {
+    std::pmr::string name;
+    SystemAccess access;
+    std::function<void()> update;
+
+    /// Positions of the later systems that conflict with this one
+    std::pmr::vector<size_t> successors;
+
+    /// Number of earlier systems that conflict with this one
+    size_t dependency_count = 0;
+  };
+
+  std::pmr::vector<ScheduledSystem> systems_;
+
+  /// Set if the scheduler was constructed with a worker count
+  std::unique_ptr<tbge::jobs::JobSystem> owned_job_system_;
+
+  tbge::jobs::JobSystem* job_system_;
+
+  /// Unfinished dependencies of each system during the current Run()
+  std::unique_ptr<std::atomic<size_t>[]> pending_dependencies_;
+
+  /// @brief Runs a system, then queues the systems waiting only for it.
+  void run_system(size_t system, tbge::jobs::TaskGroup& group);
+};
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_SCHEDULER_H_
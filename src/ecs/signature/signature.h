@@ -0,0 +1,286 @@
+/**
+ * @file signature.h
+ * @brief Fixed-size bitset of component types with a SIMD subset test.
+ *
+ * @details
+ * Replaces std::bitset for entity and system signatures. The bits are stored
+ * in 64-bit words, so a signature takes ceil(N / 64) * 8 bytes, and the
+ * operations the ECS runs on every structural change work on whole words.
+ */
+
+#ifndef TBGE_ECS_SIGNATURE_H_
+#define TBGE_ECS_SIGNATURE_H_
+
+#include <absl/log/check.h>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TBGE_ECS_SIGNATURE_SSE2 1
+#endif
+
+namespace ecs {
+
+/**
+ * @class BasicSignature
+ * @brief Set of component type IDs below kBits.
+ *
+ * @details
+ * Offers the subset of the std::bitset interface the ECS uses (set, reset,
+ * test, none, any, count, &, |, ==), plus includes() and intersects() for
+ * the word-wise tests that decide whether an entity matches a system.
+ *
+ * Signatures of up to 128 bits are handled with straight-line code on one or
+ * two words. Larger ones compare 128 bits per instruction with SSE2 where it
+ * is available, and fall back to a word loop elsewhere.
+ *
+ * @tparam kBits The number of component types the signature can hold.
+ */
+template <size_t kBits>
+class BasicSignature {
+ public:
+  /// @brief Number of 64-bit words holding the bits.
+  static constexpr size_t kWordCount = (kBits + 63) / 64;
+
+  /// @brief Constructs a signature with no bits set.
+  constexpr BasicSignature() = default;
+
+  /**
+   * @brief Constructs a signature from the bits of an integer, like
+   * std::bitset.
+   *
+   * @param bits Bit i is set if bit i of the value is set.
+   */
+  constexpr BasicSignature(unsigned long long bits) {
+    words_[0] = kBits >= 64 ? bits : bits & ((1ULL << (kBits % 64)) - 1);
+  }
+
+  /// @brief Returns the number of bits, kBits.
+  static constexpr size_t size() { return kBits; }
+
+  /**
+   * @brief Checks whether a bit is set.
+   *
+   * @param position The bit to check. Must be below kBits.
+   * @return true if the bit is set; false otherwise.
+   */
+  bool test(size_t position) const {
+    DCHECK(position < kBits)
+        << "Signature bit " << position << " is out of range.";
+    return (words_[position / 64] >> (position % 64)) & 1;
+  }
+
+  /**
+   * @brief Sets or clears a bit.
+   *
+   * @param position The bit to change. Must be below kBits.
+   * @param value Whether the bit is set afterwards.
+   * @return Reference to this signature for method chaining.
+   */
+  BasicSignature& set(size_t position, bool value = true) {
+    DCHECK(position < kBits)
+        << "Signature bit " << position << " is out of range.";
+    std::uint64_t mask = std::uint64_t{1} << (position % 64);
+    std::uint64_t& word = words_[position / 64];
+    word = value ? word | mask : word & ~mask;
+    return *this;
+  }
+
+  /// @brief Proxy to a single bit returned by the non-const operator[].
+  class reference {
+   public:
+    reference& operator=(bool value) {
+      signature_->set(position_, value);
+      return *this;
+    }
+
+    operator bool() const { return signature_->test(position_); }
+
+   private:
+    friend class BasicSignature;
+
+    reference(BasicSignature* signature, size_t position)
+        : signature_(signature), position_(position) {}
+
+    BasicSignature* signature_;
+    size_t position_;
+  };
+
+  /// @brief Returns a bit, like test().
+  bool operator[](size_t position) const { return test(position); }
+
+  /// @brief Returns an assignable proxy to a bit, like std::bitset.
+  reference operator[](size_t position) { return reference(this, position); }
+
+  /// @brief Clears a bit.
+  BasicSignature& reset(size_t position) { return set(position, false); }
+
+  /// @brief Clears every bit.
+  constexpr BasicSignature& reset() {
+    words_.fill(0);
+    return *this;
+  }
+
+  /// @brief Checks whether no bit is set.
+  constexpr bool none() const {
+    std::uint64_t any = 0;
+    for (std::uint64_t word : words_) {
+      any |= word;
+    }
+    return any == 0;
+  }
+
+  /// @brief Checks whether any bit is set.
+  constexpr bool any() const { return !none(); }
+
+  /// @brief Returns the number of set bits.
+  constexpr size_t count() const {
+    size_t count = 0;
+    for (std::uint64_t word : words_) {
+      count += static_cast<size_t>(std::popcount(word));
+    }
+    return count;
+  }
+
+  /**
+   * @brief Returns the lowest 64 bits as an integer.
+   *
+   * @note Unlike std::bitset, set bits beyond the first 64 are not reported.
+   */
+  constexpr unsigned long long to_ullong() const { return words_[0]; }
+
+  /// @copydoc to_ullong
+  constexpr unsigned long to_ulong() const {
+    return static_cast<unsigned long>(words_[0]);
+  }
+
+  /**
+   * @brief Checks whether every bit set in other is also set in this
+   * signature.
+   *
+   * @details
+   * Equivalent to `(*this & other) == other` without building the
+   * intermediate signature.
+   *
+   * @param other The required bits, e.g. a system's signature.
+   * @return true if this signature is a superset of other.
+   */
+  bool includes(const BasicSignature& other) const {
+    return !any_combined<true>(other);
+  }
+
+  /**
+   * @brief Checks whether this signature and other share a set bit.
+   *
+   * @details
+   * Equivalent to `(*this & other).any()` without building the intermediate
+   * signature.
+   *
+   * @param other The bits to look for, e.g. a system's excluded types.
+   * @return true if at least one bit is set in both signatures.
+   */
+  bool intersects(const BasicSignature& other) const {
+    return any_combined<false>(other);
+  }
+
+  constexpr BasicSignature& operator&=(const BasicSignature& other) {
+    for (size_t i = 0; i < kWordCount; ++i) {
+      words_[i] &= other.words_[i];
+    }
+    return *this;
+  }
+
+  constexpr BasicSignature& operator|=(const BasicSignature& other) {
+    for (size_t i = 0; i < kWordCount; ++i) {
+      words_[i] |= other.words_[i];
+    }
+    return *this;
+  }
+
+  friend constexpr BasicSignature operator&(BasicSignature a,
+                                            const BasicSignature& b) {
+    return a &= b;
+  }
+
+  friend constexpr BasicSignature operator|(BasicSignature a,
+                                            const BasicSignature& b) {
+    return a |= b;
+  }
+
+  friend constexpr bool operator==(const BasicSignature&,
+                                   const BasicSignature&) = default;
+
+  /// @brief Returns a hash of the bits, for unordered containers.
+  size_t get_hash() const {
+    size_t hash = 0;
+    for (std::uint64_t word : words_) {
+      hash ^= std::hash<std::uint64_t>{}(word) + 0x9e3779b97f4a7c15ULL +
+              (hash << 6) + (hash >> 2);
+    }
+    return hash;
+  }
+
+ private:
+  /// @brief Bit i is bit i % 64 of word i / 64. Bits at or above kBits are
+  /// always zero.
+  std::array<std::uint64_t, kWordCount> words_{};
+
+  /// @brief Checks whether any bit of other & words_ is set, or of
+  /// other & ~words_ if kInvertOwn.
+  template <bool kInvertOwn>
+  bool any_combined(const BasicSignature& other) const {
+    auto combine = [](std::uint64_t own, std::uint64_t required) {
+      return required & (kInvertOwn ? ~own : own);
+    };
+
+    if constexpr (kWordCount == 1) {
+      return combine(words_[0], other.words_[0]) != 0;
+    } else if constexpr (kWordCount == 2) {
+      return (combine(words_[0], other.words_[0]) |
+              combine(words_[1], other.words_[1])) != 0;
+    } else {
+      size_t i = 0;
+      std::uint64_t any = 0;
+#ifdef TBGE_ECS_SIGNATURE_SSE2
+      // Accumulate the combined bits 128 at a time and test them once at the
+      // end, so the loop has no branches to mispredict
+      __m128i any_lanes = _mm_setzero_si128();
+      for (; i + 2 <= kWordCount; i += 2) {
+        __m128i own = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(words_.data() + i));
+        __m128i required = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(other.words_.data() + i));
+        any_lanes = _mm_or_si128(any_lanes,
+                                 kInvertOwn ? _mm_andnot_si128(own, required)
+                                            : _mm_and_si128(own, required));
+      }
+      __m128i zero_bytes = _mm_cmpeq_epi8(any_lanes, _mm_setzero_si128());
+      any = _mm_movemask_epi8(zero_bytes) != 0xFFFF;
+#endif
+      for (; i < kWordCount; ++i) {
+        any |= combine(words_[i], other.words_[i]);
+      }
+      return any != 0;
+    }
+  }
+};
+
+}  // namespace ecs
+
+namespace std {
+
+template <size_t kBits>
+struct hash<ecs::BasicSignature<kBits>> {
+  size_t operator()(const ecs::BasicSignature<kBits>& signature) const {
+    return signature.get_hash();
+  }
+};
+
+}  // namespace std
+
+#endif  // TBGE_ECS_SIGNATURE_H_
@@ -0,0 +1,69 @@
+#include "src/ecs/sparse_index/sparse_index.h"
+
+#include <absl/log/check.h>
+
+#include "src/ecs/context/context.h"
+#include "src/ecs/memory/memory.h"
+
+namespace ecs {
+
+SparseIndex& SparseIndex::Set(Entity entity, Entity index) {
+  CHECK(index != kInvalidIndex)
+      << "Attempted to store the invalid index for Entity ID " << entity
+      << ". Use Erase() to remove an entity from a SparseIndex.";
+
+  size_t page = page_of(entity);
+  if (page >= pages_.size()) {
+    pages_.resize(page + 1);
+  }
+
+  // Allocate the page the first time an entity in its range is set
+  if (pages_[page] == nullptr) {
+    pages_[page] = MakeResourcePtr<Page>(pages_.get_allocator().resource());
+    pages_[page]->slots.fill(kInvalidIndex);
+    ++page_count_;
+  }
+
+  Entity& slot = pages_[page]->slots[offset_of(entity)];
+  if (slot == kInvalidIndex) {
+    ++pages_[page]->used;
+  }
+  slot = index;
+
+  return *this;
+}
+
+SparseIndex& SparseIndex::Erase(Entity entity) {
+  size_t page = page_of(entity);
+  if (page >= pages_.size() || pages_[page] == nullptr) {
+    return *this;
+  }
+
+  Entity& slot = pages_[page]->slots[offset_of(entity)];
+  if (slot == kInvalidIndex) {
+    return *this;
+  }
+  slot = kInvalidIndex;
+
+  // Free the page once its last entity is gone
+  if (--pages_[page]->used == 0) {
+    pages_[page].reset();
+    --page_count_;
+
+    // Drop trailing empty directory entries so the directory shrinks too
+    while (!pages_.empty() && pages_.back() == nullptr) {
+      pages_.pop_back();
+    }
+  }
+
+  return *this;
+}
+
+SparseIndex& SparseIndex::Clear() {
+  pages_.clear();
+  page_count_ = 0;
+
+  return *this;
+}
+
+}  // namespace ecs
@@ -0,0 +1,147 @@
+/**
+ * @file sparse_index.h
+ * @brief Paged entity-indexed lookup table for sparse sets.
+ *
+ * @details
+ * Maps entity IDs to packed indices with O(1) lookups while only allocating
+ * memory for the ranges of entity IDs that are actually populated.
+ */
+
+#ifndef TBGE_ECS_SPARSE_INDEX_H_
+#define TBGE_ECS_SPARSE_INDEX_H_
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <vector>
+
+#include "src/ecs/context/context.h"
+#include "src/ecs/memory/memory.h"
+
+namespace ecs {
+
+/**
+ * @class SparseIndex
+ * @brief Paged array mapping entity IDs to indices in a packed array.
+ *
+ * @details
+ * The entity ID range is split into pages of kSparsePageSize entries. Pages are
+ * allocated the first time an entity in their range is set and freed again once
+ * their last entity is erased, so memory scales with the populated entities
+ * rather than with the highest entity ID ever issued.
+ *
+ * A lookup is one read from the page directory and one read from the page.
+ *
+ * @note The page directory itself costs one pointer per page of entity ID
+ * range up to the highest populated page, and is trimmed when trailing pages
+ * are freed.
+ */
+class SparseIndex {
+ public:
+  /// @brief Value returned for entities that have no index.
+  static constexpr Entity kInvalidIndex = std::numeric_limits<Entity>::max();
+
+  /// @brief Number of entries in a single page.
+  static constexpr size_t kPageSize = kSparsePageSize;
+
+  /**
+   * @brief Constructs an empty SparseIndex.
+   *
+   * @param resource The memory resource pages and the page directory are
+   * allocated from. Must outlive the index.
+   */
+  explicit SparseIndex(
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : pages_(resource) {}
+
+  /**
+   * @brief Returns the index stored for the entity.
+   *
+   * @param entity The entity to look up.
+   * @return The stored index, or kInvalidIndex if the entity has none.
+   */
+  Entity Get(Entity entity) const {
+    size_t page = page_of(entity);
+    if (page >= pages_.size() || pages_[page] == nullptr) {
+      return kInvalidIndex;
+    }
+    return pages_[page]->slots[offset_of(entity)];
+  }
+
+  /**
+   * @brief Checks whether an index is stored for the entity.
+   *
+   * @param entity The entity to look up.
+   * @return true if the entity has an index; false otherwise.
+   */
+  bool Contains(Entity entity) const { return Get(entity) != kInvalidIndex; }
+
+  /**
+   * @brief Stores an index for the entity, allocating its page if needed.
+   *
+   * @param entity The entity to store the index for.
+   * @param index The index to store. Must not be kInvalidIndex.
+   * @return Reference to the current SparseIndex for method chaining.
+   */
+  SparseIndex& Set(Entity entity, Entity index);
+
+  /**
+   * @brief Removes the index stored for the entity.
+   *
+   * @details
+   * Frees the entity's page if it no longer holds any index, and shrinks the
+   * page directory if trailing pages have been freed. Erasing an entity that
+   * has no index does nothing.
+   *
+   * @param entity The entity to remove the index for.
+   * @return Reference to the current SparseIndex for method chaining.
+   */
+  SparseIndex& Erase(Entity entity);
+
+  /**
+   * @brief Removes all stored indices and frees every page.
+   *
+   * @return Reference to the current SparseIndex for method chaining.
+   */
+  SparseIndex& Clear();
+
+  /**
+   * @brief Returns the number of currently allocated pages.
+   *
+   * @return The count of allocated pages.
+   */
+  size_t get_page_count() const { return page_count_; }
+
+  /**
+   * @brief Returns the number of entries in the page directory.
+   *
+   * @return The length of the page directory, including unallocated pages.
+   */
+  size_t get_directory_size() const { return pages_.size(); }
+
+ private:
+  /// @brief A fixed-size block of indices and the number of them in use.
+  struct Page {
+    std::array<Entity, kPageSize> slots;
+    size_t used = 0;
+  };
+
+  /// @brief Page directory, indexed by entity ID / kPageSize.
+  std::pmr::vector<ResourcePtr<Page>> pages_;
+
+  /// @brief Number of non-null entries in pages_.
+  size_t page_count_ = 0;
+
+  static constexpr size_t page_of(Entity entity) {
+    return static_cast<size_t>(entity / kPageSize);
+  }
+
+  static constexpr size_t offset_of(Entity entity) {
+    return static_cast<size_t>(entity & (kPageSize - 1));
+  }
+};
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_SPARSE_INDEX_H_
@@ -11,9 +11,13 @@
 #ifndef TBGE_ECS_SYSTEM_H_
 #define TBGE_ECS_SYSTEM_H_
 
-#include <set>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <span>
 
 #include "src/ecs/context/context.h"
+#include "src/ecs/entity_set/entity_set.h"
 
 namespace ecs {
 
@@ -29,6 +33,9 @@ namespace ecs {
  *
  * The SystemManager automatically maintains the entity set based on entity
  * signatures matching the system's signature requirements.
+ *
+ * The entities are kept in an EntitySet, so iterating them walks a packed
+ * array in an unspecified order.
  */
 class System {
  public:
@@ -42,7 +49,7 @@ class System {
    *
    * @return A const reference to the set of entities.
    */
-  const std::set<Entity>& get_entities() const { return entities_; }
+  const EntitySet& get_entities() const { return entities_; }
 
   /**
    * @brief Checks if the system contains the specified entity.
@@ -61,14 +68,19 @@ class System {
    * Calls remove_entity_() for entities being removed and add_entity_() for
    * entities being added, ensuring child class overloads are invoked.
    *
+   * Both sets answer lookups in O(1), so this takes one linear pass over
+   * each of them.
+   *
    * @param entities The new set of entities to manage.
    * @return Reference to this system for method chaining.
    */
-  virtual System& set_entities(const std::set<Entity>& entities) {
-    // Remove entities no longer in the new set
-    for (Entity entity : entities_) {
-      if (!entities.contains(entity)) {
-        remove_entity_(entity);
+  virtual System& set_entities(const EntitySet& entities) {
+    // Remove entities no longer in the new set. Walk backwards, as removing
+    // moves the last entity into the freed slot.
+    std::span<const Entity> current = entities_.get_entities();
+    for (size_t i = current.size(); i-- > 0;) {
+      if (!entities.contains(current[i])) {
+        remove_entity_(current[i]);
       }
     }
 
@@ -109,20 +121,28 @@ class System {
  private:
   friend class SystemManager;
 
-  /// @brief The set of entities managed by this system.
-  std::set<Entity> entities_;
+  /// @brief The set of entities managed by this system. The SystemManager
+  /// moves it to its own memory resource on registration.
+  EntitySet entities_;
+
+  /// @brief Rebuilds the empty entity set on another memory resource.
+  /// Assigning would keep the old resource, as std::pmr containers do not
+  /// propagate their allocator.
+  System& set_memory_resource(std::pmr::memory_resource* resource) {
+    std::destroy_at(&entities_);
+    std::construct_at(&entities_, resource);
+    return *this;
+  }
 
   System& add_entity_(Entity entity) {
-    if (!entities_.contains(entity)) {
-      entities_.insert(entity);
+    if (entities_.insert(entity).second) {
       add_entity(entity);
     }
     return *this;
   }
 
   System& remove_entity_(Entity entity) {
-    if (entities_.contains(entity)) {
-      entities_.erase(entity);
+    if (entities_.erase(entity) > 0) {
       remove_entity(entity);
     }
     return *this;
@@ -3,7 +3,10 @@
 #include <absl/log/check.h>
 #include <absl/log/log.h>
 
+#include <algorithm>
 #include <memory>
+#include <memory_resource>
+#include <span>
 #include <typeinfo>
 
 #include "src/ecs/context/context.h"
@@ -22,10 +25,8 @@ namespace ecs {
  */
 SystemManager& SystemManager::EntityDestroyed(Entity entity) {
   // Erase a destroyed entity from all system lists
-  // entities_ is a set so no check needed
-  for (auto const& pair : systems_) {
-    auto const& system = pair.second;
-
+  // remove_entity_() ignores systems without the entity
+  for (auto const& system : systems_) {
     system->remove_entity_(entity);
   }
 
@@ -40,9 +41,10 @@ SystemManager& SystemManager::EntityDestroyed(Entity entity) {
  * are satisfied by the new entity signature, and removes it from systems that
  * are no longer satisfied.
  *
- * The bitwise AND check `(entitySignature & systemSignature) ==
- * systemSignature` ensures the entity has all components required by the
- * system.
+ * The subset check `entitySignature.includes(systemSignature)` ensures the
+ * entity has all components required by the system, and
+ * `entitySignature.intersects(excludedSignature)` that it has none of the
+ * excluded ones.
  *
  * @param entity The entity whose signature changed.
  * @param entitySignature The new signature representing the entity's
@@ -50,24 +52,111 @@ SystemManager& SystemManager::EntityDestroyed(Entity entity) {
  * @return Reference to this SystemManager for method chaining.
  */
 SystemManager& SystemManager::EntitySignatureChanged(
-    Entity entity, Signature entitySignature) {
+    Entity entity, const Signature& entitySignature) {
   // Notify each system that an entity's signature changed
-  for (auto const& pair : systems_) {
-    auto const& type = pair.first;
-    auto const& system = pair.second;
-    auto const& systemSignature = signatures_[type];
-
-    // Entity signature matches system signature - insert into set
-    if ((entitySignature & systemSignature) == systemSignature) {
-      system->add_entity_(entity);
+  for (size_t system = 0; system < systems_.size(); ++system) {
+    update_entity(system, entity, entitySignature);
+  }
+
+  return *this;
+}
+
+SystemManager& SystemManager::EntitySignatureChanged(
+    Entity entity, const Signature& entity_signature,
+    ComponentTypeId changed_type) {
+  // Systems that do not mention the changed type still see the same match
+  if (changed_type < systems_by_component_.size()) {
+    for (size_t system : systems_by_component_[changed_type]) {
+      update_entity(system, entity, entity_signature);
     }
-    // Entity signature does not match system signature - erase from set
-    else {
-      system->remove_entity_(entity);
+  }
+  for (size_t system : unfiltered_systems_) {
+    update_entity(system, entity, entity_signature);
+  }
+
+  return *this;
+}
+
+SystemManager& SystemManager::EntitiesSignatureChanged(
+    std::span<const Entity> entities,
+    std::span<const Signature> entity_signatures) {
+  CHECK(entities.size() == entity_signatures.size())
+      << "Every entity needs exactly one signature.";
+
+  for (size_t system = 0; system < systems_.size(); ++system) {
+    for (size_t i = 0; i < entities.size(); ++i) {
+      update_entity(system, entities[i], entity_signatures[i]);
     }
   }
 
   return *this;
 }
 
+SystemManager& SystemManager::EntitiesSignatureChanged(
+    std::span<const Entity> entities,
+    std::span<const Signature> entity_signatures,
+    std::span<const ComponentTypeId> changed_types) {
+  CHECK(entities.size() == entity_signatures.size())
+      << "Every entity needs exactly one signature.";
+
+  // Collect every system that mentions one of the types, each once
+  std::pmr::vector<size_t> affected(unfiltered_systems_,
+                                    systems_.get_allocator());
+  for (ComponentTypeId changed_type : changed_types) {
+    if (changed_type < systems_by_component_.size()) {
+      const std::pmr::vector<size_t>& systems =
+          systems_by_component_[changed_type];
+      affected.insert(affected.end(), systems.begin(), systems.end());
+    }
+  }
+  if (changed_types.size() > 1) {
+    std::sort(affected.begin(), affected.end());
+    affected.erase(std::unique(affected.begin(), affected.end()),
+                   affected.end());
+  }
+
+  for (size_t system : affected) {
+    for (size_t i = 0; i < entities.size(); ++i) {
+      update_entity(system, entities[i], entity_signatures[i]);
+    }
+  }
+
+  return *this;
+}
+
+// #########################
+// #        PRIVATE        #
+// #########################
+void SystemManager::index_signature(size_t system, const Signature& watched) {
+  auto erase_system = [system](std::pmr::vector<size_t>& systems) {
+    systems.erase(std::remove(systems.begin(), systems.end(), system),
+                  systems.end());
+  };
+
+  // Drop the entries of the previous signatures
+  Signature previous =
+      watched_signature(signatures_[system], excluded_signatures_[system]);
+  if (previous.none()) {
+    erase_system(unfiltered_systems_);
+  }
+  for (size_t type = 0; type < systems_by_component_.size(); ++type) {
+    if (previous.test(type)) {
+      erase_system(systems_by_component_[type]);
+    }
+  }
+
+  if (watched.none()) {
+    unfiltered_systems_.push_back(system);
+    return;
+  }
+  for (size_t type = 0; type < watched.size(); ++type) {
+    if (watched.test(type)) {
+      if (type >= systems_by_component_.size()) {
+        systems_by_component_.resize(type + 1);
+      }
+      systems_by_component_[type].push_back(system);
+    }
+  }
+}
+
 }  // namespace ecs
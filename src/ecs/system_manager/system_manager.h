@@ -11,11 +11,16 @@
 #ifndef TBGE_ECS_SYSTEM_MANAGER_H_
 #define TBGE_ECS_SYSTEM_MANAGER_H_
 
+#include <cstddef>
+#include <limits>
 #include <memory>
-#include <unordered_map>
+#include <memory_resource>
+#include <span>
+#include <vector>
 
 #include "src/ecs/context/context.h"
 #include "src/ecs/system/system.h"
+#include "src/ecs/type_index/type_index.h"
 
 namespace ecs {
 
@@ -32,11 +37,40 @@ namespace ecs {
  * - Notifying systems when entities are destroyed or when their signatures
  * change, allowing systems to update their internal entity lists accordingly.
  *
+ * A system matches the entities whose signature includes every type of its
+ * signature and none of the types of its excluded signature. Its optional
+ * signature lists types it reads when an entity has them, and does not affect
+ * which entities match. Both checks are a few word-wise bit operations.
+ *
+ * For each component type, the manager keeps the systems whose signature or
+ * excluded signature includes that type. When the caller names the component
+ * types that changed, only those systems and the systems with an empty
+ * signature are re-evaluated. A system with an empty signature matches
+ * entities of any type, so a change of any type can let an entity in.
+ *
  * @note This class is a core part of this Entity-Component-System (ECS)
  * architecture.
  */
 class SystemManager {
  public:
+  /**
+   * @brief Constructs a SystemManager without any systems.
+   *
+   * @param resource The memory resource systems and their entity sets are
+   * allocated from. Must outlive the manager and every system it returns.
+   */
+  explicit SystemManager(
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : resource_(resource),
+        system_by_index_(resource),
+        signatures_(resource),
+        excluded_signatures_(resource),
+        optional_signatures_(resource),
+        has_signature_(resource),
+        systems_(resource),
+        systems_by_component_(resource),
+        unfiltered_systems_(resource) {}
+
   /**
    * @brief Virtual destructor for proper cleanup.
    */
@@ -87,6 +121,57 @@ class SystemManager {
   template <typename T>
   Signature GetSignature();
 
+  /**
+   * @brief Sets the component types an entity must not have to be processed
+   * by the system.
+   *
+   * @details
+   * Entities that gain one of these types leave the system, and entities that
+   * lose the last of them join it again if they match its signature.
+   *
+   * @tparam T The type of the system.
+   * @param excluded The component types to exclude.
+   * @return Reference to the current SystemManager instance for method
+   * chaining.
+   */
+  template <typename T>
+  SystemManager& SetExcludedSignature(Signature excluded);
+
+  /**
+   * @brief Gets the excluded signature of a system of type T.
+   *
+   * @tparam T The type of the system.
+   * @return The excluded component types, empty if none were set.
+   */
+  template <typename T>
+  Signature GetExcludedSignature();
+
+  /**
+   * @brief Sets the component types the system reads when an entity has
+   * them.
+   *
+   * @details
+   * Optional types do not change which entities the system processes. The
+   * SystemManager only stores them for the caller, e.g. to build the
+   * SystemAccess a Scheduler runs the system with.
+   *
+   * @tparam T The type of the system.
+   * @param optional The optional component types.
+   * @return Reference to the current SystemManager instance for method
+   * chaining.
+   */
+  template <typename T>
+  SystemManager& SetOptionalSignature(Signature optional);
+
+  /**
+   * @brief Gets the optional signature of a system of type T.
+   *
+   * @tparam T The type of the system.
+   * @return The optional component types, empty if none were set.
+   */
+  template <typename T>
+  Signature GetOptionalSignature();
+
   /**
    * @brief Notifies all Systems that an entity has been destroyed.
    *
@@ -114,37 +199,160 @@ class SystemManager {
    * chaining.
    */
   SystemManager& EntitySignatureChanged(Entity entity,
-                                        Signature entitySignature);
+                                        const Signature& entitySignature);
+
+  /**
+   * @brief Notifies the systems affected by a change of one component type
+   * that an entity's signature changed.
+   *
+   * @details
+   * Only systems whose signature includes changed_type, and systems without a
+   * signature, are re-evaluated. The other systems cannot have changed their
+   * opinion of the entity.
+   *
+   * @param entity The entity whose signature has changed.
+   * @param entity_signature The new signature of the entity.
+   * @param changed_type The component type that was added or removed.
+   * @return Reference to the current SystemManager instance for method
+   * chaining.
+   */
+  SystemManager& EntitySignatureChanged(Entity entity,
+                                        const Signature& entity_signature,
+                                        ComponentTypeId changed_type);
+
+  /**
+   * @brief Notifies all systems that the signatures of many entities changed.
+   *
+   * @details
+   * Same as calling EntitySignatureChanged() for each entity, but looks up
+   * each system's signature once per batch instead of once per entity.
+   *
+   * @param entities The entities whose signatures changed.
+   * @param entity_signatures The new signature of each entity, in the same
+   * order.
+   * @return Reference to this SystemManager for method chaining.
+   */
+  SystemManager& EntitiesSignatureChanged(
+      std::span<const Entity> entities,
+      std::span<const Signature> entity_signatures);
+
+  /**
+   * @brief Notifies the systems affected by a change of the given component
+   * types that the signatures of many entities changed.
+   *
+   * @param entities The entities whose signatures changed.
+   * @param entity_signatures The new signature of each entity, in the same
+   * order.
+   * @param changed_types The component types that were added or removed.
+   * @return Reference to this SystemManager for method chaining.
+   */
+  SystemManager& EntitiesSignatureChanged(
+      std::span<const Entity> entities,
+      std::span<const Signature> entity_signatures,
+      std::span<const ComponentTypeId> changed_types);
 
   template <typename T>
   std::shared_ptr<T> GetSystem();
 
   /**
-   * @brief Returns the map of system signatures.
+   * @brief Returns the system signatures.
    *
-   * @return A const reference to the map from system type names to signatures.
+   * @return A const reference to the signature of each system, in
+   * registration order. Systems without a signature have an empty one.
    */
-  const std::unordered_map<const char*, Signature>& get_signatures() const {
+  const std::pmr::vector<Signature>& get_signatures() const {
     return signatures_;
   }
 
+  /// @brief Returns the excluded signature of each system, in registration
+  /// order.
+  const std::pmr::vector<Signature>& get_excluded_signatures() const {
+    return excluded_signatures_;
+  }
+
+  /// @brief Returns the optional signature of each system, in registration
+  /// order.
+  const std::pmr::vector<Signature>& get_optional_signatures() const {
+    return optional_signatures_;
+  }
+
   /**
-   * @brief Returns the map of registered systems.
+   * @brief Returns the registered systems.
    *
-   * @return A const reference to the map from system type names to system
-   * pointers.
+   * @return A const reference to the system pointers, in registration order.
    */
-  const std::unordered_map<const char*, std::shared_ptr<System>>& get_systems()
-      const {
+  const std::pmr::vector<std::shared_ptr<System>>& get_systems() const {
     return systems_;
   }
 
  private:
-  /// @brief Map from system type string pointer to a signature
-  std::unordered_map<const char*, Signature> signatures_{};
+  /// @brief Dense indices of system types, shared by all managers.
+  using SystemTypeIndex = TypeIndex<struct SystemTypeFamily>;
+
+  /// @brief Marks a type index that has no system in this manager.
+  static constexpr size_t kUnregistered = std::numeric_limits<size_t>::max();
+
+  /// @brief Resource systems and bookkeeping are allocated from
+  std::pmr::memory_resource* resource_;
+
+  /// @brief Position in systems_ of each SystemTypeIndex, or kUnregistered
+  std::pmr::vector<size_t> system_by_index_;
+
+  /// @brief Signature of each system, parallel to systems_
+  std::pmr::vector<Signature> signatures_;
+
+  /// @brief Excluded signature of each system, parallel to systems_
+  std::pmr::vector<Signature> excluded_signatures_;
+
+  /// @brief Optional signature of each system, parallel to systems_
+  std::pmr::vector<Signature> optional_signatures_;
+
+  /// @brief Whether SetSignature() was called for each system, parallel to
+  /// systems_
+  std::pmr::vector<bool> has_signature_;
+
+  /// @brief Registered systems in registration order
+  std::pmr::vector<std::shared_ptr<System>> systems_;
 
-  /// @brief Map from system type string pointer to a system pointer
-  std::unordered_map<const char*, std::shared_ptr<System>> systems_{};
+  /// @brief Positions in systems_ of the systems whose signature or excluded
+  /// signature includes each component type
+  std::pmr::vector<std::pmr::vector<size_t>> systems_by_component_;
+
+  /// @brief Positions in systems_ of the systems with an empty signature,
+  /// which are re-evaluated on every change
+  std::pmr::vector<size_t> unfiltered_systems_;
+
+  /// @brief Returns the component types whose changes can affect whether a
+  /// system matches, or an empty signature if every change can.
+  static Signature watched_signature(const Signature& signature,
+                                     const Signature& excluded) {
+    return signature.none() ? Signature() : signature | excluded;
+  }
+
+  /// @brief Moves a system from the index entries of its current watched
+  /// signature to those of watched.
+  void index_signature(size_t system, const Signature& watched);
+
+  /// @brief Adds an entity to a system or removes it, depending on whether
+  /// the system's signature matches.
+  void update_entity(size_t system, Entity entity,
+                     const Signature& entity_signature) {
+    if (entity_signature.includes(signatures_[system]) &&
+        !entity_signature.intersects(excluded_signatures_[system])) {
+      systems_[system]->add_entity_(entity);
+    } else {
+      systems_[system]->remove_entity_(entity);
+    }
+  }
+
+  /// @brief Returns the position in systems_ of system type T, or
+  /// kUnregistered.
+  template <typename T>
+  size_t find_system() const {
+    size_t type_index = SystemTypeIndex::Get<T>();
+    return type_index < system_by_index_.size() ? system_by_index_[type_index]
+                                                : kUnregistered;
+  }
 };
 
 }  // namespace ECS
@@ -4,7 +4,9 @@
 #include <absl/log/check.h>
 #include <absl/log/log.h>
 
+#include <cstddef>
 #include <memory>
+#include <memory_resource>
 #include <typeinfo>
 
 #include "src/ecs/context/context.h"
@@ -17,55 +19,116 @@ std::shared_ptr<T> SystemManager::RegisterSystem() {
   static_assert(
       std::is_base_of<System, T>::value,
       "Cannot register a system of type T. Must inherit from ECS::System");
-  const char* type_name = typeid(T).name();
+  size_t existing = find_system<T>();
 
-  if (systems_.find(type_name) != systems_.end()) {
-    LOG(WARNING) << "Registering system of typename '" << type_name
+  if (existing != kUnregistered) {
+    LOG(WARNING) << "Registering system of typename '" << typeid(T).name()
                  << "' more than once, returning existing pointer";
 
-    return std::static_pointer_cast<T>(systems_.find(type_name)->second);
+    return std::static_pointer_cast<T>(systems_[existing]);
   }
 
+  // Map the type index to the system's position
+  size_t type_index = SystemTypeIndex::Get<T>();
+  if (type_index >= system_by_index_.size()) {
+    system_by_index_.resize(type_index + 1, kUnregistered);
+  }
+  system_by_index_[type_index] = systems_.size();
+
   // Create a pointer to the system and return it so it can be used externally
-  std::shared_ptr<T> system = std::make_shared<T>();
-  systems_.insert({type_name, std::static_pointer_cast<System>(system)});
+  std::shared_ptr<T> system =
+      std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(resource_));
+  static_cast<System&>(*system).set_memory_resource(resource_);
+  unfiltered_systems_.push_back(systems_.size());
+  systems_.push_back(std::static_pointer_cast<System>(system));
+  signatures_.push_back(Signature());
+  excluded_signatures_.push_back(Signature());
+  optional_signatures_.push_back(Signature());
+  has_signature_.push_back(false);
   return system;
 }
 
 template <typename T>
 SystemManager& SystemManager::SetSignature(Signature signature) {
-  const char* type_name = typeid(T).name();
+  size_t system = find_system<T>();
 
-  if (systems_.find(type_name) == systems_.end()) {
+  if (system == kUnregistered) {
     LOG(ERROR) << "Attempted to set signature on system of typename \""
-               << type_name
+               << typeid(T).name()
                << "\" before it was registered. No signature will be "
                   "registered, this may lead to bugs and errors down the line.";
     return *this;
   }
 
-  if (signatures_.find(type_name) != signatures_.end()) {
-    // If the signature already exists, replace the value.
-    signatures_.find(type_name)->second = signature;
-  } else {
-    // Set the signature for this system
-    signatures_.insert({type_name, signature});
-  }
+  // Set or replace the signature for this system
+  index_signature(system, watched_signature(signature,
+                                            excluded_signatures_[system]));
+  signatures_[system] = signature;
+  has_signature_[system] = true;
 
   return *this;
 }
 
 template <typename T>
 Signature SystemManager::GetSignature() {
-  const char* type_name = typeid(T).name();
+  size_t system = find_system<T>();
 
-  if (signatures_.find(type_name) == signatures_.end()) {
-    LOG(WARNING) << "Signature for system of typename '" << type_name
+  if (system == kUnregistered || !has_signature_[system]) {
+    LOG(WARNING) << "Signature for system of typename '" << typeid(T).name()
                  << "' was not set. Returning empty signature.";
     return Signature();
   }
 
-  return signatures_[type_name];
+  return signatures_[system];
+}
+
+template <typename T>
+SystemManager& SystemManager::SetExcludedSignature(Signature excluded) {
+  size_t system = find_system<T>();
+
+  if (system == kUnregistered) {
+    LOG(ERROR) << "Attempted to set excluded signature on system of typename \""
+               << typeid(T).name()
+               << "\" before it was registered. No signature will be "
+                  "registered, this may lead to bugs and errors down the line.";
+    return *this;
+  }
+
+  index_signature(system, watched_signature(signatures_[system], excluded));
+  excluded_signatures_[system] = excluded;
+
+  return *this;
+}
+
+template <typename T>
+Signature SystemManager::GetExcludedSignature() {
+  size_t system = find_system<T>();
+
+  return system == kUnregistered ? Signature() : excluded_signatures_[system];
+}
+
+template <typename T>
+SystemManager& SystemManager::SetOptionalSignature(Signature optional) {
+  size_t system = find_system<T>();
+
+  if (system == kUnregistered) {
+    LOG(ERROR) << "Attempted to set optional signature on system of typename \""
+               << typeid(T).name()
+               << "\" before it was registered. No signature will be "
+                  "registered, this may lead to bugs and errors down the line.";
+    return *this;
+  }
+
+  optional_signatures_[system] = optional;
+
+  return *this;
+}
+
+template <typename T>
+Signature SystemManager::GetOptionalSignature() {
+  size_t system = find_system<T>();
+
+  return system == kUnregistered ? Signature() : optional_signatures_[system];
 }
 
 // EntityDestroyed and EntitySignatureChanged are implemented in
@@ -73,15 +136,15 @@ Signature SystemManager::GetSignature() {
 
 template <typename T>
 std::shared_ptr<T> SystemManager::GetSystem() {
-  const char* type_name = typeid(T).name();
+  size_t system = find_system<T>();
 
-  if (systems_.find(type_name) == systems_.end()) {
-    LOG(ERROR) << "System of typename \"" << type_name
+  if (system == kUnregistered) {
+    LOG(ERROR) << "System of typename \"" << typeid(T).name()
                << "\" was not registered.";
     return nullptr;
   }
 
-  return std::static_pointer_cast<T>(systems_[type_name]);
+  return std::static_pointer_cast<T>(systems_[system]);
 }
 
 }  // namespace ECS
@@ -0,0 +1,66 @@
+/**
+ * @file type_index.h
+ * @brief Dense per-type indices assigned without RTTI.
+ *
+ * @details
+ * Replaces typeid(T).name() lookups on hot paths. Each type used with a
+ * TypeIndex family receives a small integer the first time it is asked for,
+ * which managers use to index plain vectors.
+ */
+
+#ifndef TBGE_ECS_TYPE_INDEX_H_
+#define TBGE_ECS_TYPE_INDEX_H_
+
+#include <atomic>
+#include <cstddef>
+
+namespace ecs {
+
+/**
+ * @brief Assigns consecutive indices, starting at 0, to the types used with
+ * it.
+ *
+ * @details
+ * Every Family has its own counter, so component types and system types are
+ * numbered independently. Indices are unique for the whole program, not per
+ * manager, and are assigned in order of first use.
+ *
+ * Example:
+ * @code
+ *   using ComponentIndex = ecs::TypeIndex<struct ComponentFamily>;
+ *   size_t position = ComponentIndex::Get<Position>();
+ * @endcode
+ *
+ * @tparam Family Tag type separating independent index sequences.
+ */
+template <typename Family>
+class TypeIndex {
+ public:
+  /**
+   * @brief Returns the index of type T, assigning the next free one on the
+   * first call.
+   *
+   * @details
+   * The index lives in a function-local static, so it is initialized on first
+   * use, even from other static initializers, and the assignment is thread
+   * safe. Later calls are a single load.
+   *
+   * @tparam T The type to look up.
+   * @return The dense index of T within Family.
+   */
+  template <typename T>
+  static size_t Get() {
+    static const size_t index = next_index_.fetch_add(1);
+    return index;
+  }
+
+  /// @brief Returns the number of indices assigned so far.
+  static size_t get_count() { return next_index_.load(); }
+
+ private:
+  static inline std::atomic<size_t> next_index_{0};
+};
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_TYPE_INDEX_H_
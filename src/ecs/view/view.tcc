@@ -0,0 +1,94 @@
+#ifndef TBGE_ECS_VIEW_TCC_
+#define TBGE_ECS_VIEW_TCC_
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "src/ecs/component_array/component_array.h"
+#include "src/ecs/context/context.h"
+#include "src/ecs/view/view.h"
+
+namespace ecs {
+
+template <typename... Ts>
+View<Ts...>::View(typename view_internal::PoolOf<Ts>::argument... pools)
+    : pools_(hold(pools)...) {
+  // Drive the iteration with the smallest array
+  (
+      [&] {
+        if constexpr (!TagComponent<Ts>) {
+          const std::pmr::vector<Entity>& entities = pools.get_entities();
+          if (entities_ == nullptr || entities.size() < entities_->size()) {
+            entities_ = &entities;
+          }
+        }
+      }(),
+      ...);
+}
+
+template <typename... Ts>
+template <typename Func>
+const View<Ts...>& View<Ts...>::each(Func&& func) const {
+  return each(0, entities_->size(), std::forward<Func>(func));
+}
+
+template <typename... Ts>
+template <typename Func>
+const View<Ts...>& View<Ts...>::each(size_t begin, size_t end,
+                                     Func&& func) const {
+  const std::pmr::vector<Entity>& entities = *entities_;
+  for (size_t i = begin; i < end; ++i) {
+    Entity entity = entities[i];
+    if (Contains(entity)) {
+      func(entity, pool<Ts>().GetData(entity)...);
+    }
+  }
+
+  return *this;
+}
+
+template <typename... Ts>
+bool View<Ts...>::Contains(Entity entity) const {
+  return (pool<Ts>().HasData(entity) && ...);
+}
+
+// #####   Iterator   #####
+template <typename... Ts>
+View<Ts...>::Iterator::Iterator(const View* view, size_t index)
+    : view_(view), index_(index) {
+  skip_unmatched();
+}
+
+template <typename... Ts>
+typename View<Ts...>::value_type View<Ts...>::Iterator::operator*() const {
+  Entity entity = (*view_->entities_)[index_];
+  return value_type(entity, view_->template pool<Ts>().GetData(entity)...);
+}
+
+template <typename... Ts>
+typename View<Ts...>::Iterator& View<Ts...>::Iterator::operator++() {
+  ++index_;
+  skip_unmatched();
+  return *this;
+}
+
+template <typename... Ts>
+typename View<Ts...>::Iterator View<Ts...>::Iterator::operator++(int) {
+  Iterator previous = *this;
+  ++*this;
+  return previous;
+}
+
+template <typename... Ts>
+void View<Ts...>::Iterator::skip_unmatched() {
+  const std::pmr::vector<Entity>& entities = *view_->entities_;
+  while (index_ < entities.size() && !view_->Contains(entities[index_])) {
+    ++index_;
+  }
+}
+
+}  // namespace ecs
+
+#endif  // TBGE_ECS_VIEW_TCC_
@@ -0,0 +1,177 @@
+#include "src/engine/world.h"
+
+#include <absl/log/check.h>
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include "src/ecs/scheduler/scheduler.h"
+
+namespace tbge {
+namespace engine {
+
+World::World(size_t worker_count)
+    : job_system_(worker_count), scheduler_(job_system_) {}
+
+World& World::AddSystem(std::string_view name, ecs::SystemAccess access,
+                        std::function<void(Duration)> update) {
+  CHECK(update != nullptr) << "System \"" << name
+                           << "\" was added to a World without a function.";
+
+  scheduler_.Add(name, access,
+                 [this, update = std::move(update)] { update(timestep_); });
+
+  return *this;
+}
+
+World& World::AddSystem(std::string_view name,
+                        std::function<void(Duration)> update) {
+  ecs::SystemAccess access;
+  access.exclusive = true;
+
+  return AddSystem(name, access, std::move(update));
+}
+
+World& World::Run() {
+  if (mode_ == StepMode::kRealTime) {
+    run_real_time();
+  } else {
+    run_turn_based();
+  }
+
+  // Let the next Run() start. Turns that were not taken are kept for it.
+  std::lock_guard<std::mutex> lock(mutex_);
+  stopping_.store(false, std::memory_order_relaxed);
+
+  return *this;
+}
+
+World& World::Step() {
+  scheduler_.Run();
+  step_count_.fetch_add(1, std::memory_order_release);
+
+  return *this;
+}
+
+World& World::AdvanceTurn(size_t turns) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_turns_ += turns;
+  }
+  wake_.notify_one();
+
+  return *this;
+}
+
+World& World::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_.store(true, std::memory_order_relaxed);
+  }
+  wake_.notify_one();
+
+  return *this;
+}
+
+World& World::set_mode(StepMode mode) {
+  mode_ = mode;
+  return *this;
+}
+
+World& World::set_timestep(Duration timestep) {
+  CHECK(timestep > Duration::zero()) << "The timestep of a World must be "
+                                        "greater than zero.";
+  timestep_ = timestep;
+  return *this;
+}
+
+World& World::set_max_steps_per_frame(size_t max_steps_per_frame) {
+  CHECK(max_steps_per_frame > 0)
+      << "A World must take at least one step per frame.";
+  max_steps_per_frame_ = max_steps_per_frame;
+  return *this;
+}
+
+World& World::set_pacing(Pacing pacing) {
+  pacing_ = pacing;
+  return *this;
+}
+
+// #########################
+// #        PRIVATE        #
+// #########################
+void World::run_real_time() {
+  Clock::time_point previous = Clock::now();
+  Duration accumulator = Duration::zero();
+
+  while (!stopping_.load(std::memory_order_relaxed)) {
+    Clock::time_point now = Clock::now();
+    accumulator += now - previous;
+    previous = now;
+
+    size_t steps = 0;
+    while (accumulator >= timestep_ && steps < max_steps_per_frame_ &&
+           !stopping_.load(std::memory_order_relaxed)) {
+      Step();
+      accumulator -= timestep_;
+      ++steps;
+    }
+    // A Stop() during the catch-up is not a dropped step
+    if (stopping_.load(std::memory_order_relaxed)) {
+      break;
+    }
+
+    // Drop the time the cap left over, keeping the phase of the steps
+    if (accumulator >= timestep_) {
+      dropped_step_count_.fetch_add(
+          static_cast<size_t>(accumulator / timestep_),
+          std::memory_order_release);
+      accumulator %= timestep_;
+    }
+
+    wait_until(previous + (timestep_ - accumulator));
+  }
+}
+
+void World::run_turn_based() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [this] {
+        return stopping_.load(std::memory_order_relaxed) || pending_turns_ > 0;
+      });
+      if (stopping_.load(std::memory_order_relaxed)) {
+        return;
+      }
+      --pending_turns_;
+    }
+
+    Step();
+  }
+}
+
+void World::wait_until(Clock::time_point deadline) {
+  Clock::time_point sleep_deadline = deadline;
+  if (pacing_ == Pacing::kHybrid) {
+    sleep_deadline -= kHybridSpinTime;
+  }
+
+  if (pacing_ != Pacing::kSpin) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    wake_.wait_until(lock, sleep_deadline, [this] {
+      return stopping_.load(std::memory_order_relaxed);
+    });
+  }
+
+  while (Clock::now() < deadline &&
+         !stopping_.load(std::memory_order_relaxed)) {
+    std::this_thread::yield();
+  }
+}
+
+}  // namespace engine
+}  // namespace tbge
@@ -0,0 +1,272 @@
+/**
+ * @file world.h
+ * @brief Owns the ECS state of a game and steps its systems over time.
+ *
+ * @details
+ * A World runs its systems either on a fixed timestep in real time, or once
+ * per turn in turn-based games. Both loops wait without burning CPU between
+ * steps unless spinning is requested explicitly.
+ */
+
+#ifndef TBGE_ENGINE_WORLD_H_
+#define TBGE_ENGINE_WORLD_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string_view>
+
+#include "src/ecs/coordinator/coordinator.h"
+#include "src/ecs/scheduler/scheduler.h"
+#include "src/jobs/job_system.h"
+
+namespace tbge {
+namespace engine {
+
+/**
+ * @brief When the systems of a World are stepped.
+ */
+enum class StepMode {
+  /// Steps at a fixed rate, catching up on time spent in slow frames.
+  kRealTime,
+  /// Steps once per AdvanceTurn() and sleeps in between.
+  kTurnBased,
+};
+
+/**
+ * @brief How a real-time World waits for its next step.
+ */
+enum class Pacing {
+  /// Sleeps until the step is due. Uses no CPU, but wakes up a little late
+  /// depending on the timer resolution of the system.
+  kSleep,
+  /// Sleeps until shortly before the step is due and spins for the rest.
+  kHybrid,
+  /// Spins until the step is due. Most precise, but keeps a core busy.
+  kSpin,
+};
+
+/**
+ * @class World
+ * @brief Game loop around a Coordinator and the systems that update it.
+ *
+ * @details
+ * Systems are added with the component types they access and run through an
+ * ecs::Scheduler on the World's JobSystem, so systems that do not conflict
+ * run in parallel within a step.
+ *
+ * In StepMode::kRealTime, Run() accumulates the elapsed time and takes one
+ * step of get_timestep() for every full timestep accumulated. A frame takes
+ * at most get_max_steps_per_frame() steps; the time beyond that is dropped,
+ * so the world slows down under load instead of falling further and further
+ * behind.
+ *
+ * In StepMode::kTurnBased, Run() sleeps on a condition variable until
+ * AdvanceTurn() is called, typically by the thread reading the player's
+ * input, and takes one step per turn.
+ *
+ * Example:
+ * @code
+ *   tbge::engine::World world;
+ *   world.set_mode(tbge::engine::StepMode::kTurnBased);
+ *   world.AddSystem("npc", npc_access, [&](tbge::engine::World::Duration) {
+ *     npc_system->Update();
+ *   });
+ *
+ *   std::thread input([&world] {
+ *     std::string line;
+ *     while (std::getline(std::cin, line)) {
+ *       HandleCommand(line);
+ *       world.AdvanceTurn();
+ *     }
+ *     world.Stop();
+ *   });
+ *   world.Run();
+ *   input.join();
+ * @endcode
+ */
+class World {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using Duration = Clock::duration;
+
+  /// @brief Default time simulated by one real-time step, 20 steps a second.
+  static constexpr Duration kDefaultTimestep = std::chrono::milliseconds(50);
+
+  /// @brief Default cap on the steps taken to catch up in one frame.
+  static constexpr size_t kDefaultMaxStepsPerFrame = 5;
+
+  /// @brief Time before a step that Pacing::kHybrid spends spinning.
+  static constexpr Duration kHybridSpinTime = std::chrono::milliseconds(2);
+
+  /**
+   * @brief Constructs a world without entities or systems.
+   *
+   * @param worker_count The number of worker threads of the JobSystem. The
+   * thread calling Run() runs systems as well.
+   */
+  explicit World(
+      size_t worker_count = tbge::jobs::JobSystem::default_worker_count());
+
+  World(const World&) = delete;
+  World& operator=(const World&) = delete;
+
+  /**
+   * @brief Adds a system that is updated once per step.
+   *
+   * @param name The name of the system, for debugging.
+   * @param access The component types the system reads and writes.
+   * @param update Called with the timestep on every step.
+   * @return Reference to this World for method chaining.
+   */
+  World& AddSystem(std::string_view name, ecs::SystemAccess access,
+                   std::function<void(Duration)> update);
+
+  /**
+   * @brief Adds a system that runs alone, for systems that do not declare
+   * their accesses.
+   *
+   * @param name The name of the system, for debugging.
+   * @param update Called with the timestep on every step.
+   * @return Reference to this World for method chaining.
+   */
+  World& AddSystem(std::string_view name,
+                   std::function<void(Duration)> update);
+
+  /**
+   * @brief Runs the loop of the current StepMode until Stop() is called.
+   *
+   * @details
+   * Stop() may be called before Run(), from a system, or from another
+   * thread. Run() returns after the step in progress and may be called again
+   * afterwards.
+   *
+   * @return Reference to this World for method chaining.
+   */
+  World& Run();
+
+  /**
+   * @brief Updates every system once, outside of Run().
+   *
+   * @return Reference to this World for method chaining.
+   */
+  World& Step();
+
+  /**
+   * @brief Makes a turn-based Run() take turns more steps. Thread safe.
+   *
+   * @param turns The number of steps to take.
+   * @return Reference to this World for method chaining.
+   */
+  World& AdvanceTurn(size_t turns = 1);
+
+  /**
+   * @brief Makes Run() return. Thread safe.
+   *
+   * @return Reference to this World for method chaining.
+   */
+  World& Stop();
+
+  /**
+   * @brief Sets when the systems are stepped.
+   *
+   * @param mode The loop Run() uses. Must not be changed while it runs.
+   * @return Reference to this World for method chaining.
+   */
+  World& set_mode(StepMode mode);
+
+  /**
+   * @brief Sets the time simulated by one real-time step.
+   *
+   * @param timestep The timestep. Must be greater than zero.
+   * @return Reference to this World for method chaining.
+   */
+  World& set_timestep(Duration timestep);
+
+  /**
+   * @brief Sets the most steps a real-time frame takes to catch up.
+   *
+   * @param max_steps_per_frame The cap. Must be at least 1.
+   * @return Reference to this World for method chaining.
+   */
+  World& set_max_steps_per_frame(size_t max_steps_per_frame);
+
+  /**
+   * @brief Sets how a real-time World waits for its next step.
+   *
+   * @param pacing The waiting strategy.
+   * @return Reference to this World for method chaining.
+   */
+  World& set_pacing(Pacing pacing);
+
+  /// @brief Returns the Coordinator holding the entities of the world.
+  ecs::Coordinator& get_coordinator() { return coordinator_; }
+
+  /// @brief Returns the JobSystem the systems run on, e.g. for
+  /// ecs::ParallelEach().
+  tbge::jobs::JobSystem& get_job_system() { return job_system_; }
+
+  /// @brief Returns when the systems are stepped.
+  StepMode get_mode() const { return mode_; }
+
+  /// @brief Returns the time simulated by one real-time step.
+  Duration get_timestep() const { return timestep_; }
+
+  /// @brief Returns the most steps a real-time frame takes to catch up.
+  size_t get_max_steps_per_frame() const { return max_steps_per_frame_; }
+
+  /// @brief Returns how a real-time World waits for its next step.
+  Pacing get_pacing() const { return pacing_; }
+
+  /// @brief Returns the number of steps taken so far. Thread safe.
+  size_t get_step_count() const {
+    return step_count_.load(std::memory_order_acquire);
+  }
+
+  /// @brief Returns the number of real-time steps dropped by the catch-up
+  /// cap. Thread safe.
+  size_t get_dropped_step_count() const {
+    return dropped_step_count_.load(std::memory_order_acquire);
+  }
+
+ private:
+  tbge::jobs::JobSystem job_system_;
+  ecs::Coordinator coordinator_;
+  ecs::Scheduler scheduler_;
+
+  StepMode mode_ = StepMode::kRealTime;
+  Duration timestep_ = kDefaultTimestep;
+  size_t max_steps_per_frame_ = kDefaultMaxStepsPerFrame;
+  Pacing pacing_ = Pacing::kSleep;
+
+  std::atomic<size_t> step_count_ = 0;
+  std::atomic<size_t> dropped_step_count_ = 0;
+
+  /// Guards pending_turns_ and the waits for stopping_
+  std::mutex mutex_;
+
+  /// Wakes a waiting Run() on AdvanceTurn() and Stop()
+  std::condition_variable wake_;
+
+  /// Turns requested but not yet taken
+  size_t pending_turns_ = 0;
+
+  std::atomic<bool> stopping_ = false;
+
+  /// @brief Steps on the fixed timestep until stopped.
+  void run_real_time();
+
+  /// @brief Steps once per requested turn until stopped.
+  void run_turn_based();
+
+  /// @brief Waits until deadline according to the pacing, or until stopped.
+  void wait_until(Clock::time_point deadline);
+};
+
+}  // namespace engine
+}  // namespace tbge
+
+#endif  // TBGE_ENGINE_WORLD_H_
@@ -0,0 +1,151 @@
+#include "src/jobs/job_system.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace tbge {
+namespace jobs {
+
+namespace {
+
+/// Failed searches for a task before a worker goes to sleep
+constexpr int kSpinsBeforeSleep = 64;
+
+}  // namespace
+
+thread_local JobSystem::WorkerContext JobSystem::current_;
+
+TaskGroup& TaskGroup::Wait() {
+  size_t worker = job_system_->get_current_worker();
+  while (pending_.load(std::memory_order_acquire) > 0) {
+    JobSystem::Task* task = job_system_->find_task(worker);
+    if (task != nullptr) {
+      JobSystem::run_task(task);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  return *this;
+}
+
+JobSystem::JobSystem(size_t worker_count) {
+  // Create every deque before any worker can try to steal from it
+  workers_.reserve(worker_count);
+  for (size_t i = 0; i < worker_count; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (size_t i = 0; i < worker_count; ++i) {
+    workers_[i]->thread = std::thread(&JobSystem::work, this, i);
+  }
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  work_available_.notify_all();
+
+  for (std::unique_ptr<Worker>& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+// #########################
+// #        PRIVATE        #
+// #########################
+void JobSystem::submit(Task* task) {
+  size_t worker = get_current_worker();
+  if (worker != kNotAWorker) {
+    workers_[worker]->deque.Push(task);
+  } else {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shared_queue_.push_back(task);
+    shared_queue_size_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // A worker that went to sleep before this increment sees it in its wait
+  // predicate, otherwise the notification below reaches it
+  queued_.fetch_add(1, std::memory_order_seq_cst);
+  if (sleeping_.load(std::memory_order_seq_cst) > 0) {
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    work_available_.notify_one();
+  }
+}
+
+JobSystem::Task* JobSystem::find_task(size_t worker) {
+  Task* task = nullptr;
+  if (worker != kNotAWorker) {
+    task = workers_[worker]->deque.Pop();
+  }
+
+  if (task == nullptr &&
+      shared_queue_size_.load(std::memory_order_relaxed) > 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!shared_queue_.empty()) {
+      task = shared_queue_.front();
+      shared_queue_.pop_front();
+      shared_queue_size_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Steal from the other workers, starting after our own deque
+  size_t start = worker == kNotAWorker ? 0 : worker + 1;
+  for (size_t i = 0; task == nullptr && i < workers_.size(); ++i) {
+    size_t victim = (start + i) % workers_.size();
+    if (victim != worker) {
+      task = workers_[victim]->deque.Steal();
+    }
+  }
+
+  if (task != nullptr) {
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  return task;
+}
+
+void JobSystem::run_task(Task* task) {
+  task->function();
+
+  // The group may be destroyed as soon as its counter reaches zero
+  TaskGroup* group = task->group;
+  delete task;
+  group->pending_.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::work(size_t worker) {
+  current_ = {this, worker};
+
+  int spins = 0;
+  while (true) {
+    Task* task = find_task(worker);
+    if (task != nullptr) {
+      run_task(task);
+      spins = 0;
+      continue;
+    }
+
+    if (++spins < kSpinsBeforeSleep) {
+      std::this_thread::yield();
+      continue;
+    }
+    spins = 0;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    sleeping_.fetch_add(1, std::memory_order_seq_cst);
+    work_available_.wait(lock, [this] {
+      return stopping_ || queued_.load(std::memory_order_seq_cst) > 0;
+    });
+    sleeping_.fetch_sub(1, std::memory_order_relaxed);
+    if (stopping_) {
+      return;
+    }
+  }
+}
+
+}  // namespace jobs
+}  // namespace tbge
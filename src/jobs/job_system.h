@@ -0,0 +1,237 @@
+/**
+ * @file job_system.h
+ * @brief Work-stealing task scheduler shared by the whole engine.
+ *
+ * @details
+ * A JobSystem owns a fixed number of worker threads, each with its own
+ * WorkStealingDeque. Work is submitted as tasks of a TaskGroup, and waiting
+ * for a group runs queued tasks instead of blocking, so tasks may wait for
+ * tasks they spawned without tying up a thread.
+ */
+
+#ifndef TBGE_JOBS_JOB_SYSTEM_H_
+#define TBGE_JOBS_JOB_SYSTEM_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "src/jobs/work_stealing_deque.h"
+
+namespace tbge {
+namespace jobs {
+
+class JobSystem;
+
+/**
+ * @class TaskGroup
+ * @brief A set of tasks that can be waited for together.
+ *
+ * Example:
+ * @code
+ *   tbge::jobs::TaskGroup group(job_system);
+ *   group.Run([&] { LoadTerrain(); }).Run([&] { LoadItems(); });
+ *   group.Wait();
+ * @endcode
+ */
+class TaskGroup {
+ public:
+  /**
+   * @brief Constructs a group without tasks.
+   *
+   * @param job_system The JobSystem that runs the tasks. Must outlive the
+   * group.
+   */
+  explicit TaskGroup(JobSystem& job_system) : job_system_(&job_system) {}
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  /// @brief Waits for the remaining tasks.
+  ~TaskGroup() { Wait(); }
+
+  /**
+   * @brief Queues a task.
+   *
+   * @details
+   * Tasks queued from a worker go to the bottom of that worker's deque, and
+   * tasks queued from other threads to a shared queue.
+   *
+   * @tparam Func Callable taking no arguments.
+   * @param func The task to run. May queue more tasks to any group.
+   * @return Reference to this TaskGroup for method chaining.
+   */
+  template <typename Func>
+  TaskGroup& Run(Func&& func);
+
+  /**
+   * @brief Runs queued tasks until every task of the group has finished.
+   *
+   * @details
+   * The calling thread takes tasks from its own deque, the shared queue and
+   * other workers like a worker does, so waiting inside a task does not
+   * deadlock, and a JobSystem without workers runs everything here.
+   *
+   * @return Reference to this TaskGroup for method chaining.
+   */
+  TaskGroup& Wait();
+
+  /// @brief Returns the number of tasks that have not finished.
+  size_t get_pending_count() const {
+    return pending_.load(std::memory_order_acquire);
+  }
+
+ private:
+  friend class JobSystem;
+
+  JobSystem* job_system_;
+
+  /// Queued and running tasks of the group
+  std::atomic<size_t> pending_ = 0;
+};
+
+/**
+ * @class JobSystem
+ * @brief Fixed pool of worker threads that balance their tasks by stealing.
+ *
+ * @details
+ * Each worker pops the newest task of its own deque. When the deque is empty
+ * it takes tasks from the shared queue, then steals the oldest task of
+ * another worker. Workers that find nothing sleep until a task is queued.
+ *
+ * @note Every TaskGroup must have finished before the JobSystem is
+ * destroyed.
+ */
+class JobSystem {
+ public:
+  /// @brief Returned by get_current_worker() on threads that are not workers.
+  static constexpr size_t kNotAWorker = std::numeric_limits<size_t>::max();
+
+  /**
+   * @brief Starts the worker threads.
+   *
+   * @param worker_count The number of worker threads. Threads waiting for a
+   * TaskGroup run tasks too, so 0 runs every task on the waiting thread.
+   */
+  explicit JobSystem(size_t worker_count = default_worker_count());
+
+  JobSystem(const JobSystem&) = delete;
+  JobSystem& operator=(const JobSystem&) = delete;
+
+  /// @brief Stops and joins the worker threads.
+  ~JobSystem();
+
+  /// @brief Returns the number of worker threads.
+  size_t get_worker_count() const { return workers_.size(); }
+
+  /**
+   * @brief Returns the index of the calling worker thread.
+   *
+   * @return The worker index, or kNotAWorker if the calling thread is not a
+   * worker of this JobSystem.
+   */
+  size_t get_current_worker() const {
+    return current_.job_system == this ? current_.worker : kNotAWorker;
+  }
+
+  /// @brief Returns one worker per hardware thread besides the caller's.
+  static size_t default_worker_count() {
+    unsigned int hardware_threads = std::thread::hardware_concurrency();
+    return hardware_threads > 1 ? hardware_threads - 1 : 0;
+  }
+
+ private:
+  friend class TaskGroup;
+
+  struct Task {
+    std::function<void()> function;
+    TaskGroup* group;
+  };
+
+  struct Worker {
+    WorkStealingDeque<Task*> deque;
+    std::thread thread;
+  };
+
+  /// @brief The JobSystem and worker index of the current thread.
+  struct WorkerContext {
+    const JobSystem* job_system = nullptr;
+    size_t worker = kNotAWorker;
+  };
+
+  static thread_local WorkerContext current_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  /// Tasks queued by threads that are not workers, guarded by mutex_
+  std::deque<Task*> shared_queue_;
+
+  /// Size of shared_queue_, to skip the lock when it is empty
+  std::atomic<size_t> shared_queue_size_ = 0;
+
+  /// Queued tasks that no thread has taken yet. Briefly negative when a
+  /// task is taken before its submitter counted it.
+  std::atomic<std::int64_t> queued_ = 0;
+
+  /// Workers waiting on work_available_
+  std::atomic<size_t> sleeping_ = 0;
+
+  std::mutex mutex_;
+  std::condition_variable work_available_;
+  bool stopping_ = false;
+
+  /// @brief Queues a task on the current worker's deque or the shared queue.
+  void submit(Task* task);
+
+  /// @brief Takes a task for a worker, which is kNotAWorker on other threads.
+  Task* find_task(size_t worker);
+
+  /// @brief Runs a task and marks it finished in its group.
+  static void run_task(Task* task);
+
+  /// @brief Main loop of a worker thread.
+  void work(size_t worker);
+};
+
+/**
+ * @brief Calls func on consecutive chunks of [begin, end) in parallel.
+ *
+ * @details
+ * The range is split into chunks of grain_size indices. The calling thread
+ * runs the last chunk and then helps with the others until all are done.
+ *
+ * Example:
+ * @code
+ *   tbge::jobs::ParallelFor(job_system, 0, npcs.size(), 1024,
+ *                           [&](size_t begin, size_t end) {
+ *                             for (size_t i = begin; i < end; ++i) {
+ *                               Think(npcs[i]);
+ *                             }
+ *                           });
+ * @endcode
+ *
+ * @tparam Func Callable taking (size_t chunk_begin, size_t chunk_end).
+ * @param job_system The JobSystem to run the chunks on.
+ * @param begin The first index.
+ * @param end The index past the last one.
+ * @param grain_size The number of indices per chunk. Must be greater than 0.
+ * @param func The function to call for every chunk.
+ */
+template <typename Func>
+void ParallelFor(JobSystem& job_system, size_t begin, size_t end,
+                 size_t grain_size, Func&& func);
+
+}  // namespace jobs
+}  // namespace tbge
+
+#endif  // TBGE_JOBS_JOB_SYSTEM_H_
+
+#include "src/jobs/job_system.tcc"
@@ -0,0 +1,49 @@
+#ifndef TBGE_JOBS_JOB_SYSTEM_TCC_
+#define TBGE_JOBS_JOB_SYSTEM_TCC_
+
+#include <absl/log/check.h>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#include "src/jobs/job_system.h"
+
+namespace tbge {
+namespace jobs {
+
+template <typename Func>
+TaskGroup& TaskGroup::Run(Func&& func) {
+  pending_.fetch_add(1, std::memory_order_relaxed);
+  job_system_->submit(new JobSystem::Task{
+      std::function<void()>(std::forward<Func>(func)), this});
+
+  return *this;
+}
+
+template <typename Func>
+void ParallelFor(JobSystem& job_system, size_t begin, size_t end,
+                 size_t grain_size, Func&& func) {
+  CHECK(grain_size > 0) << "ParallelFor needs a grain size of at least 1.";
+  if (end <= begin) {
+    return;
+  }
+
+  TaskGroup group(job_system);
+  size_t chunk_begin = begin;
+  while (end - chunk_begin > grain_size) {
+    size_t chunk_end = chunk_begin + grain_size;
+    group.Run(
+        [&func, chunk_begin, chunk_end] { func(chunk_begin, chunk_end); });
+    chunk_begin = chunk_end;
+  }
+
+  func(chunk_begin, end);
+  group.Wait();
+}
+
+}  // namespace jobs
+}  // namespace tbge
+
+#endif  // TBGE_JOBS_JOB_SYSTEM_TCC_
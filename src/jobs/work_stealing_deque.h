@@ -0,0 +1,122 @@
+/**
+ * @file work_stealing_deque.h
+ * @brief Lock-free Chase-Lev deque of task pointers.
+ *
+ * @details
+ * Follows "Correct and Efficient Work-Stealing for Weak Memory Models" by
+ * Lê, Pop, Cohen and Zappa Nardelli, with sequentially consistent accesses in
+ * place of the standalone fences of the paper.
+ */
+
+#ifndef TBGE_JOBS_WORK_STEALING_DEQUE_H_
+#define TBGE_JOBS_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace tbge {
+namespace jobs {
+
+/**
+ * @class WorkStealingDeque
+ * @brief Deque that one owner thread pushes to and pops from at the bottom,
+ * while any thread may steal from the top.
+ *
+ * @details
+ * The owner works on its most recent tasks, which are likely still cached,
+ * and thieves take the oldest ones, which tend to be the largest. Neither end
+ * takes a lock. Only a thief racing the owner for the last task, or another
+ * thief for the same task, needs a compare-and-swap.
+ *
+ * The ring buffer doubles when it is full. Replaced buffers are kept until
+ * the deque is destroyed, since a thief may still be reading from them.
+ *
+ * @tparam T A pointer type. nullptr signals an empty deque or a lost race.
+ */
+template <typename T>
+class WorkStealingDeque {
+ public:
+  /**
+   * @brief Constructs an empty deque.
+   *
+   * @param capacity The initial capacity. Must be a power of two.
+   */
+  explicit WorkStealingDeque(size_t capacity = 256);
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  /**
+   * @brief Adds an item at the bottom. Owner thread only.
+   *
+   * @param item The item to add. Must not be nullptr.
+   */
+  void Push(T item);
+
+  /**
+   * @brief Takes the most recently pushed item. Owner thread only.
+   *
+   * @return The item, or nullptr if the deque is empty.
+   */
+  T Pop();
+
+  /**
+   * @brief Takes the oldest item. Safe from any thread.
+   *
+   * @return The item, or nullptr if the deque is empty or another thread
+   * took the item first.
+   */
+  T Steal();
+
+  /// @brief Returns an estimate of the number of items.
+  size_t get_size() const {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    std::int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+  }
+
+ private:
+  /// @brief Ring buffer indexed by the unbounded top and bottom counters.
+  struct Buffer {
+    explicit Buffer(size_t capacity)
+        : mask(capacity - 1),
+          items(std::make_unique<std::atomic<T>[]>(capacity)) {}
+
+    T Get(std::int64_t index) const {
+      return items[static_cast<size_t>(index) & mask].load(
+          std::memory_order_relaxed);
+    }
+
+    void Put(std::int64_t index, T item) {
+      items[static_cast<size_t>(index) & mask].store(
+          item, std::memory_order_relaxed);
+    }
+
+    size_t mask;
+    std::unique_ptr<std::atomic<T>[]> items;
+  };
+
+  /// Position of the oldest item, advanced by thieves
+  alignas(64) std::atomic<std::int64_t> top_ = 0;
+
+  /// Position past the newest item, moved by the owner
+  alignas(64) std::atomic<std::int64_t> bottom_ = 0;
+
+  std::atomic<Buffer*> buffer_;
+
+  /// Every buffer the deque has used, including the current one
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+
+  /// @brief Replaces the buffer with one of twice the capacity.
+  Buffer* grow(Buffer* buffer, std::int64_t top, std::int64_t bottom);
+};
+
+}  // namespace jobs
+}  // namespace tbge
+
+#endif  // TBGE_JOBS_WORK_STEALING_DEQUE_H_
+
+#include "src/jobs/work_stealing_deque.tcc"
@@ -0,0 +1,107 @@
+#ifndef TBGE_JOBS_WORK_STEALING_DEQUE_TCC_
+#define TBGE_JOBS_WORK_STEALING_DEQUE_TCC_
+
+#include <absl/log/check.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "src/jobs/work_stealing_deque.h"
+
+namespace tbge {
+namespace jobs {
+
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(size_t capacity) {
+  CHECK(capacity > 0 && (capacity & (capacity - 1)) == 0)
+      << "The capacity of a WorkStealingDeque must be a power of two, got "
+      << capacity << ".";
+
+  buffers_.push_back(std::make_unique<Buffer>(capacity));
+  buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+}
+
+template <typename T>
+void WorkStealingDeque<T>::Push(T item) {
+  std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+  std::int64_t top = top_.load(std::memory_order_acquire);
+  Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+
+  if (bottom - top > static_cast<std::int64_t>(buffer->mask)) {
+    buffer = grow(buffer, top, bottom);
+  }
+  buffer->Put(bottom, item);
+
+  // Publish the item before thieves can see the new bottom
+  bottom_.store(bottom + 1, std::memory_order_release);
+}
+
+template <typename T>
+T WorkStealingDeque<T>::Pop() {
+  std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+  Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+
+  // Reserve the bottom item before looking at top, so a thief either sees the
+  // reservation or the owner sees the thief's claim
+  bottom_.store(bottom, std::memory_order_seq_cst);
+  std::int64_t top = top_.load(std::memory_order_seq_cst);
+
+  if (top > bottom) {
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  T item = buffer->Get(bottom);
+  if (top == bottom) {
+    // Last item, race the thieves for it
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      item = nullptr;
+    }
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  return item;
+}
+
+template <typename T>
+T WorkStealingDeque<T>::Steal() {
+  std::int64_t top = top_.load(std::memory_order_seq_cst);
+  std::int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+  if (top >= bottom) {
+    return nullptr;
+  }
+
+  T item = buffer_.load(std::memory_order_acquire)->Get(top);
+  if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                    std::memory_order_relaxed)) {
+    return nullptr;
+  }
+
+  return item;
+}
+
+// #########################
+// #        PRIVATE        #
+// #########################
+template <typename T>
+typename WorkStealingDeque<T>::Buffer* WorkStealingDeque<T>::grow(
+    Buffer* buffer, std::int64_t top, std::int64_t bottom) {
+  auto larger = std::make_unique<Buffer>((buffer->mask + 1) * 2);
+  for (std::int64_t index = top; index < bottom; ++index) {
+    larger->Put(index, buffer->Get(index));
+  }
+
+  buffers_.push_back(std::move(larger));
+  buffer_.store(buffers_.back().get(), std::memory_order_release);
+
+  return buffers_.back().get();
+}
+
+}  // namespace jobs
+}  // namespace tbge
+
+#endif  // TBGE_JOBS_WORK_STEALING_DEQUE_TCC_
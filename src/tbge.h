@@ -7,6 +7,8 @@
  * single header to access all TBGE functionality including:
  *
  * - **ECS System**: Complete Entity Component System for game logic
+ * - **Jobs**: Work-stealing job system for running tasks in parallel
+ * - **Engine**: World that steps systems in real time or turn by turn
  * - **Terminal**: Text-based user interface and terminal control utilities
  * - **Future Extensions**: Additional modules and features can be added here
  *
@@ -31,6 +33,12 @@
 // Core ECS module
 #include "src/ecs/ecs.h"
 
+// Jobs
+#include "src/jobs/job_system.h"
+
+// Engine
+#include "src/engine/world.h"
+
 // Terminal
 #include "src/terminal/terminal.h"
 
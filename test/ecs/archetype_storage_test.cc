@@ -0,0 +1,170 @@
+#include "src/ecs/archetype/archetype_storage.h"
+
+#include <absl/log/initialize.h>
+#include <absl/log/log_sink.h>
+#include <absl/log/log_sink_registry.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "src/ecs/archetype/archetype.h"
+#include "src/ecs/context/context.h"
+#include "test/includes/test_log_sink.h"
+
+struct ArchetypePosition {
+  int x;
+  int y;
+};
+
+struct ArchetypeName {
+  std::string value;
+};
+
+class ArchetypeStorageTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    test_sink_ = std::make_unique<TestLogSink>();
+    absl::AddLogSink(test_sink_.get());
+    test_storage.RegisterComponentType(
+        kPosition, ecs::MakeComponentTypeInfo<ArchetypePosition>());
+    test_storage.RegisterComponentType(
+        kName, ecs::MakeComponentTypeInfo<ArchetypeName>());
+    test_sink_->Clear();
+  }
+
+  void TearDown() override {
+    absl::RemoveLogSink(test_sink_.get());
+    test_sink_->TestNoLogs();
+  }
+
+  static constexpr ecs::ComponentTypeId kPosition = 0;
+  static constexpr ecs::ComponentTypeId kName = 1;
+
+  std::unique_ptr<TestLogSink> test_sink_;
+  ecs::ArchetypeStorage test_storage;
+};
+
+TEST_F(ArchetypeStorageTest, AddAndGetComponents) {
+  test_storage.AddComponent<ArchetypePosition>(1, kPosition, {1, 2});
+  test_storage.AddComponent<ArchetypeName>(1, kName, {"Hall"});
+
+  EXPECT_TRUE(test_storage.HasComponent(1, kPosition));
+  EXPECT_TRUE(test_storage.HasComponent(1, kName));
+  EXPECT_FALSE(test_storage.HasComponent(2, kPosition));
+
+  EXPECT_EQ(test_storage.GetComponent<ArchetypePosition>(1, kPosition).y, 2);
+  EXPECT_EQ(test_storage.GetComponent<ArchetypeName>(1, kName).value, "Hall");
+
+  ecs::Signature expected;
+  expected.set(kPosition).set(kName);
+  EXPECT_EQ(test_storage.GetArchetype(1)->get_signature(), expected);
+}
+
+/**
+ * @brief Tests that removing components moves entities between archetypes
+ * without corrupting the values of other entities in the same archetype.
+ */
+TEST_F(ArchetypeStorageTest, RemoveComponentMovesEntity) {
+  test_storage.AddComponent<ArchetypePosition>(1, kPosition, {1, 1});
+  test_storage.AddComponent<ArchetypeName>(1, kName, {"First"});
+  test_storage.AddComponent<ArchetypePosition>(2, kPosition, {2, 2});
+  test_storage.AddComponent<ArchetypeName>(2, kName, {"Second"});
+
+  test_storage.RemoveComponent(1, kName);
+
+  EXPECT_FALSE(test_storage.HasComponent(1, kName));
+  EXPECT_EQ(test_storage.GetComponent<ArchetypePosition>(1, kPosition).x, 1);
+  EXPECT_EQ(test_storage.GetComponent<ArchetypeName>(2, kName).value,
+            "Second");
+  EXPECT_EQ(test_storage.GetComponent<ArchetypePosition>(2, kPosition).x, 2);
+
+  // Removing the last component drops the entity from the storage
+  test_storage.RemoveComponent(1, kPosition);
+  EXPECT_EQ(test_storage.GetArchetype(1), nullptr);
+}
+
+/**
+ * @brief Tests that transitions reuse cached archetypes instead of creating
+ * new ones.
+ */
+TEST_F(ArchetypeStorageTest, TransitionsReuseArchetypes) {
+  test_storage.AddComponent<ArchetypePosition>(1, kPosition, {});
+  test_storage.AddComponent<ArchetypeName>(1, kName, {});
+  size_t archetype_count = test_storage.get_archetypes().size();
+
+  test_storage.RemoveComponent(1, kName);
+  test_storage.AddComponent<ArchetypeName>(1, kName, {});
+  test_storage.AddComponent<ArchetypePosition>(2, kPosition, {});
+  test_storage.AddComponent<ArchetypeName>(2, kName, {});
+
+  EXPECT_EQ(test_storage.get_archetypes().size(), archetype_count);
+  EXPECT_EQ(test_storage.GetArchetype(1), test_storage.GetArchetype(2));
+}
+
+/**
+ * @brief Tests that Each visits every matching entity across several chunks
+ * and archetypes.
+ */
+TEST_F(ArchetypeStorageTest, EachVisitsMatchingChunks) {
+  constexpr ecs::Entity kEntityCount = 5000;
+  for (ecs::Entity entity = 0; entity < kEntityCount; ++entity) {
+    test_storage.AddComponent<ArchetypePosition>(
+        entity, kPosition, {static_cast<int>(entity), 0});
+    if (entity % 2 == 0) {
+      test_storage.AddComponent<ArchetypeName>(entity, kName, {"Even"});
+    }
+  }
+  EXPECT_GT(test_storage.GetArchetype(1)->get_chunk_count(), 1);
+
+  size_t visited = 0;
+  test_storage.Each<ArchetypePosition>(
+      {kPosition}, [&visited](ecs::Entity entity, ArchetypePosition& position) {
+        EXPECT_EQ(position.x, static_cast<int>(entity));
+        ++visited;
+      });
+  EXPECT_EQ(visited, kEntityCount);
+
+  visited = 0;
+  test_storage.Each<ArchetypeName, ArchetypePosition>(
+      {kName, kPosition},
+      [&visited](ecs::Entity entity, ArchetypeName& name,
+                 ArchetypePosition&) {
+        EXPECT_EQ(entity % 2, 0);
+        EXPECT_EQ(name.value, "Even");
+        ++visited;
+      });
+  EXPECT_EQ(visited, kEntityCount / 2);
+}
+
+TEST_F(ArchetypeStorageTest, EntityDestroyed) {
+  test_storage.AddComponent<ArchetypeName>(1, kName, {"One"});
+  test_storage.AddComponent<ArchetypeName>(2, kName, {"Two"});
+
+  test_storage.EntityDestroyed(1);
+  test_storage.EntityDestroyed(3);
+
+  EXPECT_FALSE(test_storage.HasComponent(1, kName));
+  EXPECT_EQ(test_storage.GetComponent<ArchetypeName>(2, kName).value, "Two");
+}
+
+TEST_F(ArchetypeStorageTest, AddComponentTwice) {
+  test_storage.AddComponent<ArchetypePosition>(1, kPosition, {1, 1});
+  test_storage.AddComponent<ArchetypePosition>(1, kPosition, {2, 2});
+
+  test_sink_->TestLogs(
+      absl::LogSeverity::kWarning,
+      "Component of type '.*' added to the same entity more than once.");
+  EXPECT_EQ(test_storage.GetComponent<ArchetypePosition>(1, kPosition).x, 1);
+}
+
+TEST_F(ArchetypeStorageTest, RemoveNonExistentComponent) {
+  test_storage.RemoveComponent(1, kPosition);
+
+  test_sink_->TestLogs(absl::LogSeverity::kWarning,
+                       "Removing non-existent component of type '.*'.");
+}
+
+TEST_F(ArchetypeStorageTest, GetNonExistentComponent) {
+  EXPECT_DEATH(test_storage.GetComponent<ArchetypePosition>(1, kPosition),
+               "Retrieving non-existent component of type '.*'.");
+}
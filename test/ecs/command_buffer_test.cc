@@ -0,0 +1,220 @@
+#include "src/ecs/command_buffer/command_buffer.h"
+
+#include <absl/log/initialize.h>
+#include <absl/log/log_sink.h>
+#include <absl/log/log_sink_registry.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "src/ecs/component/component.h"
+#include "src/ecs/coordinator/coordinator.h"
+#include "test/includes/test_log_sink.h"
+
+struct CommandHealth {
+  int points;
+};
+
+struct CommandName {
+  std::unique_ptr<std::string> name;
+};
+
+struct CommandOwner : public ecs::Component {};
+
+class CommandSystem : public ecs::System {};
+
+class CommandBufferTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    absl::SetStderrThreshold(absl::LogSeverityAtLeast::kFatal);
+    test_sink_ = std::make_unique<TestLogSink>();
+    absl::AddLogSink(test_sink_.get());
+
+    testing::internal::CaptureStdout();
+    test_coordinator = std::make_unique<ecs::Coordinator>();
+    testing::internal::GetCapturedStdout();
+    test_coordinator->RegisterComponentType<CommandHealth>();
+    test_coordinator->RegisterComponentType<CommandName>();
+    test_coordinator->RegisterComponentType<CommandOwner>();
+    test_sink_->Clear();
+  }
+
+  void TearDown() override {
+    absl::RemoveLogSink(test_sink_.get());
+    test_sink_->TestNoLogs("Tested in TearDown");
+  }
+
+  std::unique_ptr<TestLogSink> test_sink_;
+  std::unique_ptr<ecs::Coordinator> test_coordinator;
+  ecs::CommandBuffer test_command_buffer;
+};
+
+/**
+ * @brief Tests that nothing changes until Flush() and that pending entities
+ * can be targeted before they exist.
+ */
+TEST_F(CommandBufferTest, Flush) {
+  ecs::Entity entity = test_coordinator->CreateEntity();
+
+  auto pending = test_command_buffer.CreateEntity();
+  test_command_buffer.AddComponent(pending, CommandHealth{5})
+      .EmplaceComponent<CommandName>(
+          pending, std::make_unique<std::string>("pending"))
+      .AddComponent(entity, CommandHealth{7})
+      .AddComponent(entity, CommandOwner());
+  EXPECT_EQ(test_command_buffer.get_size(), 5);
+  EXPECT_FALSE(test_coordinator->HasComponent<CommandHealth>(entity));
+
+  std::pmr::vector<ecs::Entity> created =
+      test_command_buffer.Flush(*test_coordinator);
+  ASSERT_EQ(created.size(), 1);
+  EXPECT_EQ(test_command_buffer.get_size(), 0);
+
+  EXPECT_EQ(test_coordinator->GetComponent<CommandHealth>(created[0]).points,
+            5);
+  EXPECT_EQ(*test_coordinator->GetComponent<CommandName>(created[0]).name,
+            "pending");
+  EXPECT_EQ(test_coordinator->GetComponent<CommandHealth>(entity).points, 7);
+  EXPECT_EQ(test_coordinator->GetComponent<CommandOwner>(entity)
+                .get_entity_id(),
+            entity);
+}
+
+/**
+ * @brief Tests that commands may be recorded while iterating a system, and
+ * that the system sees the changes after Flush().
+ */
+TEST_F(CommandBufferTest, RecordWhileIterating) {
+  auto system = test_coordinator->RegisterSystem<CommandSystem>();
+  ecs::Signature signature;
+  signature.set(test_coordinator->GetComponentTypeId<CommandHealth>(), true);
+  test_coordinator->SetSystemSignature<CommandSystem>(signature);
+
+  std::vector<ecs::Entity> entities = test_coordinator->CreateEntities(6);
+  for (ecs::Entity entity : entities) {
+    test_coordinator->AddComponent(entity,
+                                   CommandHealth{static_cast<int>(entity)});
+  }
+
+  for (ecs::Entity entity : system->get_entities()) {
+    if (test_coordinator->GetComponent<CommandHealth>(entity).points % 2 == 0) {
+      test_command_buffer.DestroyEntity(entity);
+      test_command_buffer.AddComponent(test_command_buffer.CreateEntity(),
+                                       CommandHealth{-1});
+    }
+  }
+  EXPECT_EQ(system->get_entities().size(), 6);
+
+  test_command_buffer.Flush(*test_coordinator);
+  EXPECT_EQ(system->get_entities().size(), 6);
+  for (ecs::Entity entity : system->get_entities()) {
+    int points = test_coordinator->GetComponent<CommandHealth>(entity).points;
+    EXPECT_TRUE(points == -1 || points % 2 == 1);
+  }
+}
+
+/**
+ * @brief Tests that the commands per entity and component type are coalesced
+ * into their net effect, and that destroyed entities get no component
+ * commands.
+ */
+TEST_F(CommandBufferTest, Coalesce) {
+  ecs::Entity entity1 = test_coordinator->CreateEntity();
+  ecs::Entity entity2 = test_coordinator->CreateEntity();
+  ecs::Entity entity3 = test_coordinator->CreateEntity();
+  ecs::Entity entity4 = test_coordinator->CreateEntity();
+  test_coordinator->AddComponent(entity1, CommandHealth{1});
+  test_coordinator->AddComponent(entity4, CommandHealth{4});
+
+  test_command_buffer.RemoveComponent<CommandHealth>(entity1)
+      .AddComponent(entity1, CommandHealth{2})
+      .AddComponent(entity2, CommandHealth{3})
+      .RemoveComponent<CommandHealth>(entity2)
+      .AddComponent(entity2, CommandName{std::make_unique<std::string>("x")})
+      .DestroyEntity(entity2)
+      .DestroyEntity(entity2)
+      .AddComponent(entity3, CommandHealth{5})
+      .RemoveComponent<CommandHealth>(entity3)
+      .RemoveComponent<CommandHealth>(entity4)
+      .AddComponent(entity4, CommandHealth{6})
+      .RemoveComponent<CommandHealth>(entity4);
+  test_command_buffer.Flush(*test_coordinator);
+
+  // Removing and adding replaces the component
+  EXPECT_EQ(test_coordinator->GetComponent<CommandHealth>(entity1).points, 2);
+  EXPECT_EQ(test_coordinator->CreateEntity(), entity2);
+  EXPECT_FALSE(test_coordinator->HasComponent<CommandHealth>(entity2));
+  EXPECT_FALSE(test_coordinator->HasComponent<CommandName>(entity2));
+
+  // Adding and removing leaves the entity as it was
+  EXPECT_FALSE(test_coordinator->HasComponent<CommandHealth>(entity3));
+  EXPECT_FALSE(test_coordinator->HasComponent<CommandHealth>(entity4));
+}
+
+/**
+ * @brief Tests that Flush() removes the components of one type for every
+ * entity before the systems are notified, once per entity.
+ */
+TEST_F(CommandBufferTest, FlushBatchesRemovals) {
+  class CountingSystem : public ecs::System {
+   public:
+    ecs::Coordinator* coordinator = nullptr;
+    std::vector<ecs::Entity> watched;
+    int removed = 0;
+    int still_present = 0;
+
+   protected:
+    System& remove_entity(ecs::Entity) override {
+      ++removed;
+      for (ecs::Entity entity : watched) {
+        still_present += coordinator->HasComponent<CommandHealth>(entity);
+      }
+      return *this;
+    }
+  };
+
+  auto system = test_coordinator->RegisterSystem<CountingSystem>();
+  ecs::Signature signature;
+  signature.set(test_coordinator->GetComponentTypeId<CommandHealth>(), true);
+  test_coordinator->SetSystemSignature<CountingSystem>(signature);
+
+  constexpr size_t kCount = 100;
+  std::vector<ecs::Entity> entities =
+      test_coordinator->CreateEntities(kCount);
+  test_coordinator->AddComponents<CommandHealth>(entities, CommandHealth{1});
+  system->coordinator = test_coordinator.get();
+  system->watched = entities;
+
+  for (ecs::Entity entity : entities) {
+    test_command_buffer.RemoveComponent<CommandHealth>(entity);
+  }
+  test_command_buffer.Flush(*test_coordinator);
+
+  EXPECT_EQ(system->removed, kCount);
+  EXPECT_EQ(system->still_present, 0);
+  EXPECT_TRUE(system->get_entities().empty());
+}
+
+/**
+ * @brief Tests that dropped commands destroy their payloads.
+ */
+TEST_F(CommandBufferTest, Clear) {
+  auto name = std::make_shared<int>(0);
+  struct SharedName {
+    std::shared_ptr<int> name;
+  };
+  test_coordinator->RegisterComponentType<SharedName>();
+
+  test_command_buffer.AddComponent(test_coordinator->CreateEntity(),
+                                   SharedName{name});
+  EXPECT_EQ(name.use_count(), 2);
+  test_command_buffer.Clear();
+  EXPECT_EQ(name.use_count(), 1);
+  EXPECT_EQ(test_command_buffer.get_size(), 0);
+
+  // Flushing an empty buffer changes nothing
+  EXPECT_TRUE(test_command_buffer.Flush(*test_coordinator).empty());
+}
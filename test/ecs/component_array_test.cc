@@ -14,6 +14,33 @@ struct TestComponent {
   }
 };
 
+struct CopyCountingComponent {
+  static inline int copies = 0;
+  static inline int moves = 0;
+
+  CopyCountingComponent(int value = 0) : value(value) {}
+  CopyCountingComponent(const CopyCountingComponent& other)
+      : value(other.value) {
+    ++copies;
+  }
+  CopyCountingComponent(CopyCountingComponent&& other) noexcept
+      : value(other.value) {
+    ++moves;
+  }
+  CopyCountingComponent& operator=(const CopyCountingComponent& other) {
+    value = other.value;
+    ++copies;
+    return *this;
+  }
+  CopyCountingComponent& operator=(CopyCountingComponent&& other) noexcept {
+    value = other.value;
+    ++moves;
+    return *this;
+  }
+
+  int value;
+};
+
 class ComponentArrayTest : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -141,4 +168,129 @@ TEST_F(ComponentArrayTest, GetComponent) {
 TEST_F(ComponentArrayTest, GettingNonexistentComponent) {
   EXPECT_DEATH(test_component_array.GetData(255),
                "Retrieving non-existent component of type '.*'.");
-}
\ No newline at end of file
+}
+/**
+ * @brief Tests that removing a component keeps the remaining components
+ * reachable through their entities.
+ *
+ * @details
+ * Removal moves the last packed component into the freed slot. This test
+ * verifies that the moved component is still retrieved through its own entity
+ * and that the removed entity no longer reports data.
+ */
+TEST_F(ComponentArrayTest, RemoveComponentKeepsOthersReachable) {
+  ecs::Entity entity3 = 300;
+  test_component_array.InsertData(entity1, component1);
+  test_component_array.InsertData(entity2, component2);
+  test_component_array.InsertData(entity3, TestComponent{30});
+
+  test_component_array.RemoveData(entity1);
+
+  EXPECT_EQ(test_component_array.get_size(), 2);
+  EXPECT_FALSE(test_component_array.HasData(entity1));
+  EXPECT_TRUE(test_component_array.HasData(entity2));
+  EXPECT_TRUE(test_component_array.HasData(entity3));
+  EXPECT_EQ(test_component_array.GetData(entity2), component2);
+  EXPECT_EQ(test_component_array.GetData(entity3), TestComponent{30});
+
+  test_component_array.InsertData(entity1, component1);
+  EXPECT_EQ(test_component_array.GetData(entity1), component1);
+}
+
+/**
+ * @brief Tests that moving, emplacing and removing components never copies
+ * them.
+ *
+ * @details
+ * Inserting an lvalue makes exactly one copy. Inserting an rvalue or
+ * constructing in place with EmplaceData() makes none, and the swap-remove in
+ * RemoveData() moves the last component instead of copying it.
+ */
+TEST_F(ComponentArrayTest, MoveAndEmplaceDoNotCopy) {
+  ecs::ComponentArray<CopyCountingComponent> component_array;
+  CopyCountingComponent lvalue(1);
+  CopyCountingComponent::copies = 0;
+
+  component_array.InsertData(entity1, lvalue);
+  EXPECT_EQ(CopyCountingComponent::copies, 1);
+
+  CopyCountingComponent::copies = 0;
+  component_array.InsertData(entity2, CopyCountingComponent(2));
+  component_array.EmplaceData(3, 3);
+  component_array.RemoveData(entity1);
+  EXPECT_EQ(CopyCountingComponent::copies, 0);
+
+  EXPECT_EQ(component_array.GetData(3).value, 3);
+  EXPECT_EQ(component_array.GetData(entity2).value, 2);
+}
+
+/**
+ * @brief Tests that both sort strategies reorder the packed components while
+ * every entity keeps its own component.
+ */
+TEST_F(ComponentArrayTest, Sort) {
+  for (ecs::SortStrategy strategy :
+       {ecs::SortStrategy::kFull, ecs::SortStrategy::kInsertion}) {
+    ecs::ComponentArray<TestComponent> component_array;
+    const int values[] = {40, 10, 50, 30, 20, 60};
+    for (ecs::Entity entity = 0; entity < 6; ++entity) {
+      component_array.InsertData(entity, TestComponent{values[entity]});
+    }
+
+    component_array.Sort(
+        [](const TestComponent& first, const TestComponent& second) {
+          return first.value < second.value;
+        },
+        strategy);
+
+    const auto& entities = component_array.get_entities();
+    for (size_t i = 0; i < component_array.get_size(); ++i) {
+      ecs::Entity entity = entities[i];
+      EXPECT_EQ(component_array.GetIndex(entity), i);
+      EXPECT_EQ(component_array.GetData(entity).value, values[entity]);
+      EXPECT_EQ(values[entity], static_cast<int>(i + 1) * 10);
+    }
+
+    component_array.SortByEntity(strategy);
+    for (size_t i = 0; i < component_array.get_size(); ++i) {
+      EXPECT_EQ(entities[i], i);
+      EXPECT_EQ(component_array.GetData(entities[i]).value, values[i]);
+    }
+  }
+}
+
+/**
+ * @brief Tests that removed components are destroyed right away and that
+ * unused capacity is released on request or by the shrink policy.
+ */
+TEST_F(ComponentArrayTest, RemoveDestroysAndShrinks) {
+  struct ResourceComponent {
+    std::shared_ptr<int> resource;
+  };
+  ecs::ComponentArray<ResourceComponent> component_array;
+  auto resource = std::make_shared<int>(1);
+  for (ecs::Entity entity = 0; entity < 100; ++entity) {
+    component_array.InsertData(entity, ResourceComponent{resource});
+  }
+  EXPECT_EQ(resource.use_count(), 101);
+
+  for (ecs::Entity entity = 0; entity < 90; ++entity) {
+    component_array.RemoveData(entity);
+  }
+  EXPECT_EQ(resource.use_count(), 11);
+  EXPECT_GE(component_array.get_capacity(), 100);
+
+  component_array.ShrinkToFit();
+  EXPECT_EQ(component_array.get_capacity(), 10);
+  EXPECT_EQ(component_array.GetData(95).resource, resource);
+
+  // Shrinks once fewer than half of the slots are used
+  component_array.set_shrink_policy({.min_load_factor = 0.5f});
+  for (ecs::Entity entity = 90; entity < 95; ++entity) {
+    component_array.RemoveData(entity);
+  }
+  EXPECT_EQ(component_array.get_capacity(), 10);
+  component_array.RemoveData(95);
+  EXPECT_EQ(component_array.get_capacity(), 4);
+  EXPECT_EQ(resource.use_count(), 5);
+}
@@ -144,4 +144,30 @@ TEST(Context, SignatureUsage) {
   sig1[0] = 1;
   sig1[2] = 1;
   EXPECT_EQ(sig1.count(), 2);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Test that an EntityHandle packs the entity ID and its generation.
+ * The generation checks only apply when ECS_ENTITY_GENERATION_BITS is not 0,
+ * as in tbge_generations_test.
+ */
+TEST(Context, EntityHandlePacking) {
+  EXPECT_EQ(ecs::kEntityIndexBits + ecs::kEntityGenerationBits,
+            ECS_ENTITY_CONFIG);
+
+  ecs::EntityHandle handle(5, 3);
+  EXPECT_EQ(handle.get_entity(), 5);
+  if (ecs::kEntityGenerationBits > 0) {
+    EXPECT_EQ(handle.get_generation(), 3);
+    EXPECT_NE(handle, ecs::EntityHandle(5, 4));
+  }
+  EXPECT_EQ(handle, ecs::EntityHandle(5, 3));
+
+  // Generations wrap around instead of spilling into the ID
+  ecs::EntityHandle wrapped(5, ecs::EntityHandle::kGenerationMask + 1);
+  EXPECT_EQ(wrapped.get_entity(), 5);
+  EXPECT_EQ(wrapped.get_generation(), 0);
+
+  // The default handle refers to an ID that is never handed out
+  EXPECT_GE(ecs::EntityHandle().get_entity(), ecs::kMaxEntities);
+}
@@ -5,6 +5,17 @@
 #include <absl/log/log_sink_registry.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/ecs/command_buffer/command_buffer.h"
+#include "src/jobs/job_system.h"
 #include "test/includes/test_log_sink.h"
 
 class DummyComponent {
@@ -19,6 +30,54 @@ class DummyComponent2 {
   int value;
 };
 
+class InventoryComponent : public ecs::Component {
+ public:
+  static inline int copies = 0;
+
+  InventoryComponent(std::vector<std::string> items)
+      : items(std::move(items)) {}
+  InventoryComponent(const InventoryComponent& other)
+      : ecs::Component(other), items(other.items) {
+    ++copies;
+  }
+  InventoryComponent(InventoryComponent&&) = default;
+  InventoryComponent& operator=(const InventoryComponent& other) {
+    ecs::Component::operator=(other);
+    items = other.items;
+    ++copies;
+    return *this;
+  }
+  InventoryComponent& operator=(InventoryComponent&&) = default;
+
+  std::vector<std::string> items;
+};
+
+/**
+ * @brief Memory resource that tracks the bytes it hands out.
+ */
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  size_t allocations = 0;
+  size_t bytes_in_use = 0;
+
+ private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    bytes_in_use += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+    bytes_in_use -= bytes;
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept
+      override {
+    return this == &other;
+  }
+};
+
 class CoordinatorTest : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -73,6 +132,25 @@ TEST_F(CoordinatorTest, CreateEntity) {
   EXPECT_EQ(entity3, 2);
 }
 
+/**
+ * @brief Tests that a handle stops being alive once its entity is destroyed,
+ * even after the ID is recycled.
+ */
+TEST_F(CoordinatorTest, EntityHandles) {
+  ecs::Entity entity = test_coordinator->CreateEntity();
+  ecs::EntityHandle handle = test_coordinator->GetHandle(entity);
+  EXPECT_TRUE(test_coordinator->IsAlive(handle));
+  EXPECT_EQ(test_coordinator->GetEntity(handle), entity);
+
+  // A handle outlives its entity without aliasing the recycled ID
+  test_coordinator->DestroyEntity(entity);
+  EXPECT_FALSE(test_coordinator->IsAlive(handle));
+  EXPECT_EQ(test_coordinator->CreateEntity(), entity);
+  if (ecs::kEntityGenerationBits > 0) {
+    EXPECT_FALSE(test_coordinator->IsAlive(handle));
+  }
+}
+
 TEST_F(CoordinatorTest, RegisterComponentType) {
   ecs::ComponentManager* component_manager =
       test_coordinator->get_component_manager();
@@ -392,4 +470,503 @@ TEST_F(CoordinatorTest, SetSystemSignatureOfUnregisteredSystem) {
       "Attempted to set signature on system of typename \".*\" before it was "
       "registered. No signature will be registered, this may lead to bugs and "
       "errors down the line.");
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Tests that entities with an excluded component leave the system and
+ * come back once they lose it.
+ */
+TEST_F(CoordinatorTest, SetSystemExcludedSignature) {
+  struct Hidden {};
+  test_coordinator->RegisterComponentType<DummyComponent>();
+  test_coordinator->RegisterComponentType<Hidden>();
+  auto system = test_coordinator->RegisterSystem<DummySystem>();
+
+  ecs::Signature required;
+  required.set(test_coordinator->GetComponentTypeId<DummyComponent>());
+  ecs::Signature excluded;
+  excluded.set(test_coordinator->GetComponentTypeId<Hidden>());
+  test_coordinator->SetSystemSignature<DummySystem>(required)
+      .SetSystemExcludedSignature<DummySystem>(excluded)
+      .SetSystemOptionalSignature<DummySystem>(ecs::Signature(0b100));
+
+  std::vector<ecs::Entity> entities = test_coordinator->CreateEntities(3);
+  test_coordinator->AddComponents<DummyComponent>(entities, DummyComponent());
+  test_coordinator->AddComponent(entities[1], Hidden{});
+  EXPECT_TRUE(system->has_entity(entities[0]));
+  EXPECT_FALSE(system->has_entity(entities[1]));
+  EXPECT_FALSE(test_coordinator->EntityIsValidForSystem<DummySystem>(
+      entities[1]));
+
+  // Losing the excluded component lets the entity back in
+  test_coordinator->RemoveComponent<Hidden>(entities[1]);
+  EXPECT_TRUE(system->has_entity(entities[1]));
+  EXPECT_EQ(system->get_entities().size(), 3);
+}
+
+/**
+ * @brief Tests that systems may create entities when an entity enters them,
+ * while the other systems are still being matched against its signature.
+ */
+TEST_F(CoordinatorTest, SystemCreatesEntities) {
+  class SpawningSystem : public ecs::System {
+   public:
+    ecs::Coordinator* coordinator = nullptr;
+
+   protected:
+    System& add_entity(ecs::Entity) override {
+      coordinator->CreateEntities(1000);
+      return *this;
+    }
+  };
+
+  test_coordinator->RegisterComponentType<DummyComponent>();
+  auto spawning_system = test_coordinator->RegisterSystem<SpawningSystem>();
+  auto system = test_coordinator->RegisterSystem<DummySystem>();
+  spawning_system->coordinator = test_coordinator.get();
+
+  ecs::Signature required;
+  required.set(test_coordinator->GetComponentTypeId<DummyComponent>());
+  test_coordinator->SetSystemSignature<SpawningSystem>(required)
+      .SetSystemSignature<DummySystem>(required);
+
+  ecs::Entity entity = test_coordinator->CreateEntity();
+  test_coordinator->AddComponent(entity, DummyComponent());
+  EXPECT_TRUE(spawning_system->has_entity(entity));
+  EXPECT_TRUE(system->has_entity(entity));
+}
+
+/**
+ * @brief Tests adding, reading, visiting and removing components with
+ * StorageMode::kArchetypes.
+ */
+TEST_F(CoordinatorTest, ArchetypeStorageMode) {
+  testing::internal::CaptureStdout();
+  ecs::Coordinator coordinator(ecs::StorageMode::kArchetypes);
+  testing::internal::GetCapturedStdout();
+  test_sink_->Clear();
+
+  coordinator.RegisterComponentType<DummyComponent>();
+  coordinator.RegisterComponentType<DummyComponent2>();
+  ecs::Entity entity = coordinator.CreateEntity();
+  ecs::Entity entity2 = coordinator.CreateEntity();
+
+  coordinator.AddComponent<DummyComponent>(entity, DummyComponent(1));
+  coordinator.AddComponent<DummyComponent2>(entity, DummyComponent2(2));
+  coordinator.AddComponent<DummyComponent>(entity2, DummyComponent(3));
+
+  EXPECT_EQ(coordinator.get_storage_mode(), ecs::StorageMode::kArchetypes);
+  EXPECT_EQ(coordinator.GetEntitySignature(entity), ecs::Signature(0b11));
+  EXPECT_EQ(coordinator.GetComponent<DummyComponent>(entity).value, 1);
+  EXPECT_EQ(coordinator.GetComponent<DummyComponent2>(entity).value, 2);
+  EXPECT_TRUE(coordinator.HasComponent<DummyComponent>(entity2));
+  EXPECT_FALSE(coordinator.HasComponent<DummyComponent2>(entity2));
+
+  int sum = 0;
+  coordinator.Each<DummyComponent>(
+      [&sum](ecs::Entity, DummyComponent& component) {
+        sum += component.value;
+      });
+  EXPECT_EQ(sum, 4);
+
+  coordinator.RemoveComponent<DummyComponent>(entity);
+  coordinator.DestroyEntity(entity2);
+  EXPECT_FALSE(coordinator.HasComponent<DummyComponent>(entity));
+  EXPECT_EQ(coordinator.GetComponent<DummyComponent2>(entity).value, 2);
+  EXPECT_FALSE(coordinator.HasComponent<DummyComponent>(entity2));
+}
+
+/**
+ * @brief Tests that Each visits only the entities that have every component
+ * type.
+ */
+TEST_F(CoordinatorTest, Each) {
+  test_coordinator->RegisterComponentType<DummyComponent>();
+  test_coordinator->RegisterComponentType<DummyComponent2>();
+  ecs::Entity entity = test_coordinator->CreateEntity();
+  ecs::Entity entity2 = test_coordinator->CreateEntity();
+  test_coordinator->AddComponent<DummyComponent>(entity, DummyComponent(1));
+  test_coordinator->AddComponent<DummyComponent>(entity2, DummyComponent(2));
+  test_coordinator->AddComponent<DummyComponent2>(entity2, DummyComponent2(3));
+
+  int visited = 0;
+  test_coordinator->Each<DummyComponent, DummyComponent2>(
+      [&](ecs::Entity visited_entity, DummyComponent& component,
+          DummyComponent2& component2) {
+        EXPECT_EQ(visited_entity, entity2);
+        EXPECT_EQ(component.value, 2);
+        EXPECT_EQ(component2.value, 3);
+        ++visited;
+      });
+  EXPECT_EQ(visited, 1);
+}
+
+/**
+ * @brief Tests that emplacing, adding and moving components between archetypes
+ * never copies them, in both storage modes.
+ */
+TEST_F(CoordinatorTest, EmplaceComponentDoesNotCopy) {
+  for (ecs::StorageMode storage_mode :
+       {ecs::StorageMode::kComponentArrays, ecs::StorageMode::kArchetypes}) {
+    testing::internal::CaptureStdout();
+    ecs::Coordinator coordinator(storage_mode);
+    testing::internal::GetCapturedStdout();
+    test_sink_->Clear();
+
+    coordinator.RegisterComponentType<InventoryComponent>();
+    coordinator.RegisterComponentType<DummyComponent>();
+    ecs::Entity entity = coordinator.CreateEntity();
+    ecs::Entity entity2 = coordinator.CreateEntity();
+    InventoryComponent::copies = 0;
+
+    coordinator.EmplaceComponent<InventoryComponent>(
+        entity, std::vector<std::string>{"lamp", "rope"});
+    coordinator.AddComponent<InventoryComponent>(
+        entity2, InventoryComponent({"key"}));
+    // Archetype mode moves the inventory to a new archetype here
+    coordinator.AddComponent<DummyComponent>(entity, DummyComponent(1));
+    coordinator.RemoveComponent<InventoryComponent>(entity);
+    EXPECT_EQ(InventoryComponent::copies, 0);
+
+    InventoryComponent& inventory =
+        coordinator.GetComponent<InventoryComponent>(entity2);
+    EXPECT_EQ(inventory.items, std::vector<std::string>{"key"});
+    EXPECT_EQ(inventory.get_entity_id(), entity2);
+
+    coordinator.EmplaceComponent<InventoryComponent>(
+        entity, std::vector<std::string>{"map"});
+    EXPECT_EQ(coordinator.GetComponent<InventoryComponent>(entity)
+                  .get_entity_id(),
+              entity);
+  }
+}
+
+/**
+ * @brief Tests that batched additions store every component and notify the
+ * systems, in both storage modes.
+ */
+TEST_F(CoordinatorTest, AddComponentsInBatch) {
+  for (ecs::StorageMode storage_mode :
+       {ecs::StorageMode::kComponentArrays, ecs::StorageMode::kArchetypes}) {
+    testing::internal::CaptureStdout();
+    ecs::Coordinator coordinator(storage_mode);
+    testing::internal::GetCapturedStdout();
+    test_sink_->Clear();
+
+    coordinator.RegisterComponentType<DummyComponent>();
+    coordinator.RegisterComponentType<DummyComponent2>();
+    auto system = coordinator.RegisterSystem<DummySystem>();
+    coordinator.SetSystemSignature<DummySystem>(ecs::Signature(0b11));
+
+    std::vector<ecs::Entity> entities = coordinator.CreateEntities(3);
+    ASSERT_EQ(entities.size(), 3);
+    std::vector<DummyComponent> components{DummyComponent(1),
+                                           DummyComponent(2),
+                                           DummyComponent(3)};
+
+    coordinator.AddComponents<DummyComponent>(entities, components);
+    EXPECT_TRUE(system->get_entities().empty());
+
+    coordinator.AddComponents<DummyComponent2>(entities, DummyComponent2(7));
+    EXPECT_EQ(system->get_entities().size(), 3);
+
+    for (size_t i = 0; i < entities.size(); ++i) {
+      EXPECT_EQ(coordinator.GetEntitySignature(entities[i]),
+                ecs::Signature(0b11));
+      EXPECT_EQ(coordinator.GetComponent<DummyComponent>(entities[i]).value,
+                components[i].value);
+      EXPECT_EQ(coordinator.GetComponent<DummyComponent2>(entities[i]).value,
+                7);
+    }
+  }
+}
+
+/**
+ * @brief Tests that batched additions set the entity ID of components that
+ * inherit from Component.
+ */
+TEST_F(CoordinatorTest, AddComponentsSetsEntityIds) {
+  test_coordinator->RegisterComponentType<InventoryComponent>();
+  test_coordinator->RegisterComponentType<DummyComponent>();
+  std::vector<ecs::Entity> entities = test_coordinator->CreateEntities(2);
+
+  test_coordinator->AddComponents<InventoryComponent, DummyComponent>(
+      entities, InventoryComponent({"torch"}), DummyComponent(4));
+
+  for (ecs::Entity entity : entities) {
+    EXPECT_EQ(test_coordinator->GetComponent<InventoryComponent>(entity)
+                  .get_entity_id(),
+              entity);
+    EXPECT_EQ(test_coordinator->GetComponent<DummyComponent>(entity).value, 4);
+  }
+}
+
+/**
+ * @brief Tests that a pool keeps its address and shares its data with
+ * GetComponent.
+ */
+TEST_F(CoordinatorTest, GetPool) {
+  test_coordinator->RegisterComponentType<DummyComponent>();
+  ecs::ComponentArray<DummyComponent>& pool =
+      test_coordinator->GetPool<DummyComponent>();
+
+  // Registering more types must not move existing pools
+  test_coordinator->RegisterComponentType<DummyComponent2>();
+  test_coordinator->RegisterComponentType<InventoryComponent>();
+  EXPECT_EQ(&test_coordinator->GetPool<DummyComponent>(), &pool);
+
+  ecs::Entity entity = test_coordinator->CreateEntity();
+  test_coordinator->AddComponent<DummyComponent>(entity, DummyComponent(5));
+  EXPECT_TRUE(pool.HasData(entity));
+  pool.GetData(entity).value = 6;
+  EXPECT_EQ(test_coordinator->GetComponent<DummyComponent>(entity).value, 6);
+}
+
+/**
+ * @brief Tests that sorting a pool changes the iteration order of its views.
+ */
+TEST_F(CoordinatorTest, Sort) {
+  test_coordinator->RegisterComponentType<DummyComponent>();
+  std::vector<ecs::Entity> entities = test_coordinator->CreateEntities(5);
+  for (ecs::Entity entity : entities) {
+    test_coordinator->AddComponent<DummyComponent>(
+        entity, DummyComponent(100 - static_cast<int>(entity)));
+  }
+
+  test_coordinator->Sort<DummyComponent>(
+      [](const DummyComponent& first, const DummyComponent& second) {
+        return first.value < second.value;
+      });
+
+  int previous = 0;
+  for (auto [entity, component] : test_coordinator->View<DummyComponent>()) {
+    EXPECT_LT(previous, component.value);
+    EXPECT_EQ(component.value, 100 - static_cast<int>(entity));
+    previous = component.value;
+  }
+
+  test_coordinator->SortByEntity<DummyComponent>(ecs::SortStrategy::kInsertion);
+  EXPECT_TRUE(std::ranges::equal(
+      test_coordinator->GetPool<DummyComponent>().get_entities(), entities));
+}
+
+/**
+ * @brief Tests that Compact releases the capacity of the pools and that the
+ * shrink policy reaches pools registered later.
+ */
+TEST_F(CoordinatorTest, Compact) {
+  test_coordinator->RegisterComponentType<DummyComponent>();
+  std::vector<ecs::Entity> entities = test_coordinator->CreateEntities(64);
+  test_coordinator->AddComponents<DummyComponent>(entities, DummyComponent(1));
+  for (ecs::Entity entity : entities) {
+    test_coordinator->DestroyEntity(entity);
+  }
+  ecs::ComponentArray<DummyComponent>& pool =
+      test_coordinator->GetPool<DummyComponent>();
+  EXPECT_GE(pool.get_capacity(), 64);
+
+  test_coordinator->Compact();
+  EXPECT_EQ(pool.get_capacity(), 0);
+
+  // Pools registered after setting the policy pick it up
+  test_coordinator->set_shrink_policy({.min_load_factor = 0.25f});
+  test_coordinator->RegisterComponentType<DummyComponent2>();
+  EXPECT_EQ(test_coordinator->GetPool<DummyComponent2>()
+                .get_shrink_policy()
+                .min_load_factor,
+            0.25f);
+}
+
+/**
+ * @brief Tests that a Coordinator allocates only from its memory resource and
+ * returns everything to it.
+ */
+TEST_F(CoordinatorTest, MemoryResource) {
+  for (ecs::StorageMode storage_mode :
+       {ecs::StorageMode::kComponentArrays, ecs::StorageMode::kArchetypes}) {
+    CountingResource world_resource;
+    CountingResource default_resource;
+    std::pmr::memory_resource* previous_default =
+        std::pmr::set_default_resource(&default_resource);
+
+    {
+      testing::internal::CaptureStdout();
+      ecs::Coordinator coordinator(storage_mode, &world_resource);
+      testing::internal::GetCapturedStdout();
+      test_sink_->Clear();
+      EXPECT_EQ(coordinator.get_memory_resource(), &world_resource);
+
+      coordinator.RegisterComponentType<DummyComponent>();
+      coordinator.RegisterComponentType<DummyComponent2>();
+      auto system = coordinator.RegisterSystem<DummySystem>();
+      coordinator.SetSystemSignature<DummySystem>(ecs::Signature(0b11));
+
+      std::vector<ecs::Entity> entities = coordinator.CreateEntities(100);
+      coordinator.AddComponents<DummyComponent>(entities, DummyComponent(1));
+      coordinator.AddComponents<DummyComponent2>(entities, DummyComponent2(2));
+      coordinator.DestroyEntity(entities[0]);
+      EXPECT_EQ(system->get_entities().size(), 99);
+    }
+
+    std::pmr::set_default_resource(previous_default);
+
+    // Everything came from the world's resource and went back to it
+    EXPECT_GT(world_resource.allocations, 0);
+    EXPECT_EQ(world_resource.bytes_in_use, 0);
+    EXPECT_EQ(default_resource.allocations, 0);
+  }
+}
+
+/**
+ * @brief Tests that the temporary buffers of batch additions, sorting and
+ * CommandBuffer flushes are allocated from the world's resource too.
+ */
+TEST_F(CoordinatorTest, TemporaryAllocations) {
+  CountingResource world_resource;
+  CountingResource default_resource;
+  std::pmr::memory_resource* previous_default =
+      std::pmr::set_default_resource(&default_resource);
+
+  {
+    testing::internal::CaptureStdout();
+    ecs::Coordinator coordinator(ecs::StorageMode::kComponentArrays,
+                                 &world_resource);
+    testing::internal::GetCapturedStdout();
+    test_sink_->Clear();
+    coordinator.RegisterComponentType<DummyComponent>();
+
+    std::pmr::vector<ecs::Entity> entities(100, &world_resource);
+    coordinator.CreateEntities(entities);
+    coordinator.AddComponents<DummyComponent>(entities, DummyComponent(1));
+    std::span<const ecs::Entity> removed(entities.begin() + 1, entities.end());
+    for (ecs::Entity entity : removed) {
+      coordinator.RemoveComponent<DummyComponent>(entity);
+    }
+
+    // The pool and its sparse page keep their capacity, so only the temporary
+    // buffers allocate
+    size_t allocations = world_resource.allocations;
+    size_t bytes_in_use = world_resource.bytes_in_use;
+    coordinator.AddComponents<DummyComponent>(removed, DummyComponent(1));
+    EXPECT_GT(world_resource.allocations, allocations);
+    EXPECT_EQ(world_resource.bytes_in_use, bytes_in_use);
+
+    allocations = world_resource.allocations;
+    coordinator.Sort<DummyComponent>(
+        [](const DummyComponent& first, const DummyComponent& second) {
+          return first.value > second.value;
+        });
+    EXPECT_GT(world_resource.allocations, allocations);
+    EXPECT_EQ(world_resource.bytes_in_use, bytes_in_use);
+
+    ecs::CommandBuffer commands(&world_resource);
+    commands.CreateEntity();
+    commands.RemoveComponent<DummyComponent>(entities[0]);
+    allocations = world_resource.allocations;
+    std::pmr::vector<ecs::Entity> created = commands.Flush(coordinator);
+    EXPECT_GT(world_resource.allocations, allocations);
+    EXPECT_EQ(created.get_allocator().resource(), &world_resource);
+    EXPECT_EQ(created.size(), 1);
+  }
+
+  std::pmr::set_default_resource(previous_default);
+
+  EXPECT_EQ(world_resource.bytes_in_use, 0);
+  EXPECT_EQ(default_resource.allocations, 0);
+}
+
+/**
+ * @brief Tests that ParallelEach visits every matching entity exactly once,
+ * with any grain size.
+ */
+TEST_F(CoordinatorTest, ParallelEach) {
+  struct Owned {};
+  test_coordinator->RegisterComponentType<DummyComponent>();
+  test_coordinator->RegisterComponentType<Owned>();
+
+  tbge::jobs::JobSystem job_system(3);
+  std::vector<ecs::Entity> entities = test_coordinator->CreateEntities(1000);
+  for (ecs::Entity entity : entities) {
+    test_coordinator->AddComponent(entity, DummyComponent(0));
+    if (entity % 4 == 0) {
+      test_coordinator->AddComponent(entity, Owned());
+    }
+  }
+
+  for (size_t grain_size : {1, 64, 5000}) {
+    std::atomic<size_t> visited = 0;
+    ecs::ParallelEach<DummyComponent, Owned>(
+        *test_coordinator, job_system,
+        [&visited](ecs::Entity entity, DummyComponent& component, Owned&) {
+          EXPECT_EQ(entity % 4, 0);
+          ++component.value;
+          visited.fetch_add(1);
+        },
+        grain_size);
+    EXPECT_EQ(visited.load(), 250);
+  }
+
+  for (ecs::Entity entity : entities) {
+    EXPECT_EQ(test_coordinator->GetComponent<DummyComponent>(entity).value,
+              entity % 4 == 0 ? 3 : 0);
+  }
+}
+
+/**
+ * @brief Tests that changes recorded inside ParallelEach are applied after it,
+ * in chunk order.
+ */
+TEST_F(CoordinatorTest, ParallelEachRecord) {
+  test_coordinator->RegisterComponentType<DummyComponent>();
+
+  tbge::jobs::JobSystem job_system(3);
+  std::vector<ecs::Entity> entities = test_coordinator->CreateEntities(100);
+  for (ecs::Entity entity : entities) {
+    test_coordinator->AddComponent(entity,
+                                   DummyComponent(static_cast<int>(entity)));
+  }
+
+  ecs::ParallelEach<DummyComponent>(
+      *test_coordinator, job_system,
+      [](ecs::CommandBuffer& commands, ecs::Entity entity,
+         const DummyComponent& component) {
+        if (component.value % 2 == 0) {
+          commands.DestroyEntity(entity);
+          commands.AddComponent(commands.CreateEntity(),
+                                DummyComponent(-component.value));
+        }
+      },
+      10);
+
+  size_t count = 0;
+  test_coordinator->Each<DummyComponent>(
+      [&count](ecs::Entity, const DummyComponent& component) {
+        EXPECT_TRUE(component.value <= 0 || component.value % 2 == 1);
+        ++count;
+      });
+  EXPECT_EQ(count, 100);
+
+  // A Flush destroys entities last, so the first chunk's entities get fresh
+  // IDs from 100 upwards. Later chunks recycle the IDs the earlier ones freed.
+  EXPECT_EQ(test_coordinator->GetComponent<DummyComponent>(100).value, 0);
+  EXPECT_EQ(test_coordinator->GetComponent<DummyComponent>(104).value, -8);
+  EXPECT_EQ(test_coordinator->GetComponent<DummyComponent>(0).value, -10);
+}
+
+/**
+ * @brief Tests that structural changes during ParallelEach abort.
+ */
+TEST_F(CoordinatorTest, ParallelEachStructuralChange) {
+  test_coordinator->RegisterComponentType<DummyComponent>();
+
+  tbge::jobs::JobSystem job_system(0);
+  test_coordinator->AddComponent(test_coordinator->CreateEntity(),
+                                 DummyComponent(1));
+
+  EXPECT_DEATH(ecs::ParallelEach<DummyComponent>(
+                   *test_coordinator, job_system,
+                   [this](ecs::Entity entity, DummyComponent&) {
+                     test_coordinator->RemoveComponent<DummyComponent>(entity);
+                   }),
+               "Attempted to remove a component during ParallelEach");
+}
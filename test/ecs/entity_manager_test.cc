@@ -9,6 +9,7 @@
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include "src/ecs/context/context.h"
 #include "test/includes/test_log_sink.h"
@@ -47,6 +48,23 @@ TEST_F(EntityManagerTest, CreateEntities) {
   EXPECT_EQ(test_entity_manager.get_current_entity_count(), 5);
 }
 
+TEST_F(EntityManagerTest, CreateEntitiesInBatch) {
+  test_entity_manager.CreateEntity();
+  test_entity_manager.CreateEntity();
+  test_entity_manager.CreateEntity();
+  test_entity_manager.DestroyEntity(1);
+
+  // Recycled IDs come first, then fresh consecutive ones
+  std::vector<ecs::Entity> entities = test_entity_manager.CreateEntities(4);
+  EXPECT_EQ(entities, (std::vector<ecs::Entity>{1, 3, 4, 5}));
+  EXPECT_EQ(test_entity_manager.get_current_entity_count(), 6);
+  EXPECT_EQ(test_entity_manager.get_entity_id_counter(), 6);
+  EXPECT_EQ(test_entity_manager.GetSignature(5), ecs::Signature());
+
+  EXPECT_TRUE(test_entity_manager.CreateEntities(0).empty());
+  EXPECT_EQ(test_entity_manager.CreateEntity(), 6);
+}
+
 TEST_F(EntityManagerTest, CreateTooManyEntities) {
   // Since Entity max can be very large (depending on ECS_ENTITY_CONFIG),
   // we can't practically test the hard limit in this test.
@@ -157,6 +175,95 @@ TEST_F(EntityManagerTest, HasEntity) {
   EXPECT_FALSE(test_entity_manager.HasEntity(invalid_entity));
 }
 
+TEST_F(EntityManagerTest, DestroyEntityTwice) {
+  ecs::Entity entity = test_entity_manager.CreateEntity();
+  test_entity_manager.DestroyEntity(entity);
+  test_entity_manager.DestroyEntity(entity);
+  test_sink_->TestLogs(absl::LogSeverity::kError,
+                       "Attempted to destroy Entity ID .+ more than once.");
+
+  // The ID was recycled only once
+  EXPECT_EQ(test_entity_manager.CreateEntity(), entity);
+  EXPECT_EQ(test_entity_manager.CreateEntity(), entity + 1);
+}
+
+TEST_F(EntityManagerTest, Handles) {
+  ecs::Entity entity = test_entity_manager.CreateEntity();
+  ecs::EntityHandle handle = test_entity_manager.GetHandle(entity);
+  EXPECT_TRUE(test_entity_manager.IsAlive(handle));
+  EXPECT_EQ(test_entity_manager.GetEntity(handle), entity);
+  EXPECT_FALSE(test_entity_manager.IsAlive(ecs::EntityHandle()));
+
+  // A recycled ID gets a new generation. Only with generations enabled does
+  // the old handle stay dead, as it aliases the recycled ID otherwise.
+  test_entity_manager.DestroyEntity(entity);
+  EXPECT_FALSE(test_entity_manager.IsAlive(handle));
+  ecs::Entity recycled = test_entity_manager.CreateEntity();
+  ASSERT_EQ(recycled, entity);
+  ecs::EntityHandle recycled_handle = test_entity_manager.GetHandle(recycled);
+  EXPECT_TRUE(test_entity_manager.IsAlive(recycled_handle));
+  if (ecs::kEntityGenerationBits > 0) {
+    EXPECT_FALSE(test_entity_manager.IsAlive(handle));
+    EXPECT_EQ(recycled_handle.get_generation(), handle.get_generation() + 1);
+  }
+
+  // Batch created entities get handles as well
+  std::vector<ecs::Entity> entities = test_entity_manager.CreateEntities(2);
+  EXPECT_TRUE(
+      test_entity_manager.IsAlive(test_entity_manager.GetHandle(entities[1])));
+
+  EXPECT_DEATH(test_entity_manager.GetHandle(invalid_entity),
+               "Attempted to get a handle to a non-existent Entity");
+#ifndef NDEBUG
+  if (ecs::kEntityGenerationBits > 0) {
+    EXPECT_DEATH(test_entity_manager.GetEntity(handle),
+                 "Resolving a stale handle");
+  }
+#endif
+}
+
+TEST_F(EntityManagerTest, RecycleOrder) {
+  EXPECT_EQ(test_entity_manager.get_recycle_order(), ecs::RecycleOrder::kFifo);
+  test_entity_manager.CreateEntities(6);
+
+  auto destroy = [this] {
+    test_entity_manager.DestroyEntity(3);
+    test_entity_manager.DestroyEntity(1);
+    test_entity_manager.DestroyEntity(4);
+  };
+
+  destroy();
+  EXPECT_EQ(test_entity_manager.CreateEntities(3),
+            (std::vector<ecs::Entity>{3, 1, 4}));
+
+  test_entity_manager.set_recycle_order(ecs::RecycleOrder::kLifo);
+  destroy();
+  EXPECT_EQ(test_entity_manager.CreateEntities(3),
+            (std::vector<ecs::Entity>{4, 1, 3}));
+
+  test_entity_manager.set_recycle_order(ecs::RecycleOrder::kLowestFirst);
+  destroy();
+  EXPECT_EQ(test_entity_manager.CreateEntity(), 1);
+  test_entity_manager.DestroyEntity(0);
+  EXPECT_EQ(test_entity_manager.CreateEntities(4),
+            (std::vector<ecs::Entity>{0, 3, 4, 6}));
+
+  // Switching orders hands out the already free IDs by ID
+  test_entity_manager.DestroyEntity(5);
+  test_entity_manager.DestroyEntity(2);
+  test_entity_manager.set_recycle_order(ecs::RecycleOrder::kFifo);
+  EXPECT_EQ(test_entity_manager.CreateEntity(), 2);
+  EXPECT_EQ(test_entity_manager.CreateEntity(), 5);
+  EXPECT_EQ(test_entity_manager.get_current_entity_count(), 7);
+
+  test_entity_manager.DestroyEntity(6);
+  test_entity_manager.DestroyEntity(1);
+  test_entity_manager.set_recycle_order(ecs::RecycleOrder::kLowestFirst);
+  EXPECT_EQ(test_entity_manager.CreateEntity(), 1);
+  EXPECT_EQ(test_entity_manager.CreateEntity(), 6);
+  EXPECT_EQ(test_entity_manager.CreateEntity(), 7);
+}
+
 TEST_F(EntityManagerTest, SetSignature) {
   // Create an entity
   ecs::Entity entity = test_entity_manager.CreateEntity();
@@ -206,6 +313,19 @@ TEST_F(EntityManagerTest, SetGetSignatureDoesNotAffectOtherEntities) {
   EXPECT_EQ(test_entity_manager.GetSignature(entity2), signature2);
 }
 
+TEST_F(EntityManagerTest, SetSignatureBit) {
+  ecs::Entity entity1 = test_entity_manager.CreateEntity();
+  ecs::Entity entity2 = test_entity_manager.CreateEntity();
+  const ecs::Signature& signature = test_entity_manager.GetSignature(entity1);
+
+  // The returned reference observes changes made in place
+  test_entity_manager.SetSignatureBit(entity1, 3, true)
+      .SetSignatureBit(entity1, 5, true)
+      .SetSignatureBit(entity1, 3, false);
+  EXPECT_EQ(signature, ecs::Signature(1 << 5));
+  EXPECT_EQ(test_entity_manager.GetSignature(entity2), ecs::Signature());
+}
+
 TEST_F(EntityManagerTest, SetSignatureOnEntityOutOfRange) {
   ecs::Signature signature1(1);
   test_entity_manager.SetSignature(invalid_entity, signature1);
@@ -0,0 +1,129 @@
+#include "src/ecs/entity_set/entity_set.h"
+
+#include <absl/log/initialize.h>
+#include <absl/log/log_sink.h>
+#include <absl/log/log_sink_registry.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory_resource>
+#include <vector>
+
+#include "src/ecs/context/context.h"
+#include "test/includes/test_log_sink.h"
+
+class EntitySetTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    test_sink_ = std::make_unique<TestLogSink>();
+    absl::AddLogSink(test_sink_.get());
+    test_sink_->Clear();
+  }
+
+  void TearDown() override {
+    absl::RemoveLogSink(test_sink_.get());
+    test_sink_->TestNoLogs();
+  }
+
+  std::unique_ptr<TestLogSink> test_sink_;
+  ecs::EntitySet test_entity_set;
+};
+
+/**
+ * @brief Tests inserting entities and looking them up.
+ */
+TEST_F(EntitySetTest, Insert) {
+  EXPECT_TRUE(test_entity_set.empty());
+  EXPECT_TRUE(test_entity_set.insert(3).second);
+  EXPECT_TRUE(test_entity_set.insert(1).second);
+  auto [position, inserted] = test_entity_set.insert(3);
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(position, test_entity_set.begin());
+
+  EXPECT_EQ(test_entity_set.size(), 2);
+  EXPECT_TRUE(test_entity_set.contains(3));
+  EXPECT_EQ(test_entity_set.count(1), 1);
+  EXPECT_EQ(test_entity_set.count(2), 0);
+  EXPECT_EQ(*test_entity_set.find(1), 1);
+  EXPECT_EQ(test_entity_set.find(2), test_entity_set.end());
+
+  // Entities are iterated in insertion order until one is erased
+  std::vector<ecs::Entity> visited(test_entity_set.begin(),
+                                   test_entity_set.end());
+  EXPECT_EQ(visited, (std::vector<ecs::Entity>{3, 1}));
+}
+
+/**
+ * @brief Tests that erasing keeps the packed array without gaps.
+ */
+TEST_F(EntitySetTest, Erase) {
+  for (ecs::Entity entity : {10, 20, 30, 40}) {
+    test_entity_set.insert(entity);
+  }
+
+  EXPECT_EQ(test_entity_set.erase(20), 1);
+  EXPECT_EQ(test_entity_set.erase(20), 0);
+  EXPECT_EQ(test_entity_set.erase(99), 0);
+  EXPECT_EQ(std::vector<ecs::Entity>(test_entity_set.begin(),
+                                     test_entity_set.end()),
+            (std::vector<ecs::Entity>{10, 40, 30}));
+
+  // The moved entity is still found at its new position
+  EXPECT_EQ(test_entity_set.erase(40), 1);
+  EXPECT_EQ(test_entity_set.erase(30), 1);
+  EXPECT_FALSE(test_entity_set.contains(40));
+  EXPECT_TRUE(test_entity_set.contains(10));
+  EXPECT_EQ(test_entity_set.size(), 1);
+
+  test_entity_set.clear();
+  EXPECT_TRUE(test_entity_set.empty());
+  EXPECT_FALSE(test_entity_set.contains(10));
+}
+
+/**
+ * @brief Tests that erasing through iterators visits every entity, like the
+ * erase loops written for std::set.
+ */
+TEST_F(EntitySetTest, EraseIterator) {
+  for (ecs::Entity entity : {10, 20, 30, 40}) {
+    test_entity_set.insert(entity);
+  }
+
+  std::vector<ecs::Entity> visited;
+  for (auto it = test_entity_set.begin(); it != test_entity_set.end();) {
+    visited.push_back(*it);
+    if (*it % 20 == 0) {
+      it = test_entity_set.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  std::sort(visited.begin(), visited.end());
+  EXPECT_EQ(visited, (std::vector<ecs::Entity>{10, 20, 30, 40}));
+  EXPECT_EQ(std::vector<ecs::Entity>(test_entity_set.begin(),
+                                     test_entity_set.end()),
+            (std::vector<ecs::Entity>{10, 30}));
+}
+
+/**
+ * @brief Tests that copies hold the same entities on their own resource.
+ */
+TEST_F(EntitySetTest, Copy) {
+  std::pmr::monotonic_buffer_resource resource;
+  ecs::EntitySet entity_set(&resource);
+  entity_set.insert(5);
+  entity_set.insert(7);
+
+  test_entity_set.insert(1);
+  test_entity_set = entity_set;
+  ecs::EntitySet copy(test_entity_set);
+  entity_set.erase(5);
+
+  for (const ecs::EntitySet* set : {&test_entity_set, &copy}) {
+    EXPECT_EQ(set->size(), 2);
+    EXPECT_TRUE(set->contains(5));
+    EXPECT_TRUE(set->contains(7));
+    EXPECT_FALSE(set->contains(1));
+  }
+}
@@ -0,0 +1,135 @@
+#include "src/ecs/group/group.h"
+
+#include <absl/log/initialize.h>
+#include <absl/log/log_sink.h>
+#include <absl/log/log_sink_registry.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+
+#include "src/ecs/coordinator/coordinator.h"
+#include "test/includes/test_log_sink.h"
+
+struct GroupPosition {
+  int x;
+};
+
+struct GroupVelocity {
+  int dx;
+};
+
+struct GroupHealth {
+  int hp;
+};
+
+class GroupTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    absl::SetStderrThreshold(absl::LogSeverityAtLeast::kFatal);
+    test_sink_ = std::make_unique<TestLogSink>();
+    absl::AddLogSink(test_sink_.get());
+
+    testing::internal::CaptureStdout();
+    test_coordinator = std::make_unique<ecs::Coordinator>();
+    testing::internal::GetCapturedStdout();
+    test_coordinator->RegisterComponentType<GroupPosition>();
+    test_coordinator->RegisterComponentType<GroupVelocity>();
+    test_coordinator->RegisterComponentType<GroupHealth>();
+    test_sink_->Clear();
+  }
+
+  void TearDown() override {
+    absl::RemoveLogSink(test_sink_.get());
+    test_sink_->TestNoLogs("Tested in TearDown");
+  }
+
+  /// @brief Checks that the grouped range lines up in both arrays.
+  void ExpectPacked(const ecs::Group<GroupPosition, GroupVelocity>& group) {
+    auto& positions = test_coordinator->GetPool<GroupPosition>();
+    auto& velocities = test_coordinator->GetPool<GroupVelocity>();
+    for (size_t i = 0; i < group.get_size(); ++i) {
+      EXPECT_EQ(positions.get_entities()[i], velocities.get_entities()[i]);
+    }
+  }
+
+  std::unique_ptr<TestLogSink> test_sink_;
+  std::unique_ptr<ecs::Coordinator> test_coordinator;
+};
+
+/**
+ * @brief Tests that a group created over existing data packs the matching
+ * entities and tracks later additions and removals.
+ */
+TEST_F(GroupTest, TracksMembership) {
+  ecs::Entity still = test_coordinator->CreateEntity();
+  ecs::Entity mover = test_coordinator->CreateEntity();
+  test_coordinator->AddComponent<GroupPosition>(still, GroupPosition{1});
+  test_coordinator->AddComponent<GroupPosition>(mover, GroupPosition{2});
+  test_coordinator->AddComponent<GroupVelocity>(mover, GroupVelocity{20});
+
+  auto& group = test_coordinator->Group<GroupPosition, GroupVelocity>();
+  EXPECT_EQ(group.get_size(), 1);
+  EXPECT_TRUE(group.Contains(mover));
+  EXPECT_FALSE(group.Contains(still));
+  ExpectPacked(group);
+
+  test_coordinator->AddComponent<GroupVelocity>(still, GroupVelocity{10});
+  EXPECT_EQ(group.get_size(), 2);
+  EXPECT_TRUE(group.Contains(still));
+  ExpectPacked(group);
+
+  test_coordinator->RemoveComponent<GroupPosition>(mover);
+  EXPECT_EQ(group.get_size(), 1);
+  EXPECT_FALSE(group.Contains(mover));
+  ExpectPacked(group);
+
+  test_coordinator->DestroyEntity(still);
+  EXPECT_EQ(group.get_size(), 0);
+
+  auto& same_group = test_coordinator->Group<GroupPosition, GroupVelocity>();
+  EXPECT_EQ(&same_group, &group);
+}
+
+/**
+ * @brief Tests that each() visits every grouped entity with its own
+ * components after many reorderings.
+ */
+TEST_F(GroupTest, Each) {
+  auto& group = test_coordinator->Group<GroupPosition, GroupVelocity>();
+
+  std::set<ecs::Entity> expected;
+  for (int i = 0; i < 20; ++i) {
+    ecs::Entity entity = test_coordinator->CreateEntity();
+    test_coordinator->AddComponent<GroupPosition>(entity, GroupPosition{i});
+    if (i % 2 == 0) {
+      test_coordinator->AddComponent<GroupVelocity>(entity, GroupVelocity{i});
+      expected.insert(entity);
+    }
+  }
+  for (int i = 0; i < 20; i += 4) {
+    test_coordinator->RemoveComponent<GroupVelocity>(i);
+    expected.erase(i);
+  }
+
+  std::set<ecs::Entity> visited;
+  group.each([&](ecs::Entity entity, GroupPosition& position,
+                 GroupVelocity& velocity) {
+    EXPECT_EQ(position.x, static_cast<int>(entity));
+    EXPECT_EQ(velocity.dx, static_cast<int>(entity));
+    visited.insert(entity);
+  });
+  EXPECT_EQ(visited, expected);
+  EXPECT_EQ(group.get_size(), expected.size());
+  ExpectPacked(group);
+}
+
+/**
+ * @brief Tests that a component type cannot be owned by two groups.
+ */
+TEST_F(GroupTest, OverlappingGroups) {
+  test_coordinator->Group<GroupPosition, GroupVelocity>();
+
+  EXPECT_DEATH((test_coordinator->Group<GroupVelocity, GroupHealth>()),
+               "Component type '.*' is already owned by another group.");
+}
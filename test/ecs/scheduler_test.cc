@@ -0,0 +1,165 @@
+#include "src/ecs/scheduler/scheduler.h"
+
+#include <absl/log/initialize.h>
+#include <absl/log/log_sink.h>
+#include <absl/log/log_sink_registry.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/ecs/context/context.h"
+#include "src/jobs/job_system.h"
+#include "test/includes/test_log_sink.h"
+
+class SchedulerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    test_sink_ = std::make_unique<TestLogSink>();
+    absl::AddLogSink(test_sink_.get());
+    test_sink_->Clear();
+  }
+
+  void TearDown() override {
+    absl::RemoveLogSink(test_sink_.get());
+    test_sink_->TestNoLogs();
+  }
+
+  /// @brief Returns an access that reads and writes the given type bits.
+  static ecs::SystemAccess MakeAccess(unsigned long long reads,
+                                      unsigned long long writes) {
+    ecs::SystemAccess access;
+    access.reads = ecs::Signature(reads);
+    access.writes = ecs::Signature(writes);
+    return access;
+  }
+
+  std::unique_ptr<TestLogSink> test_sink_;
+};
+
+/**
+ * @brief Tests which accesses conflict.
+ */
+TEST_F(SchedulerTest, ConflictsWith) {
+  EXPECT_FALSE(MakeAccess(0b01, 0).ConflictsWith(MakeAccess(0b01, 0)));
+  EXPECT_FALSE(MakeAccess(0b01, 0b10).ConflictsWith(MakeAccess(0b01, 0b100)));
+  EXPECT_TRUE(MakeAccess(0b01, 0).ConflictsWith(MakeAccess(0, 0b01)));
+  EXPECT_TRUE(MakeAccess(0, 0b01).ConflictsWith(MakeAccess(0b01, 0)));
+  EXPECT_TRUE(MakeAccess(0, 0b01).ConflictsWith(MakeAccess(0, 0b01)));
+
+  ecs::SystemAccess exclusive;
+  exclusive.exclusive = true;
+  EXPECT_TRUE(exclusive.ConflictsWith(ecs::SystemAccess()));
+}
+
+/**
+ * @brief Tests that conflicting systems depend on earlier ones and run in the
+ * order they were added.
+ */
+TEST_F(SchedulerTest, ConflictingSystemsRunInOrder) {
+  ecs::Scheduler scheduler(3);
+  std::mutex mutex;
+  std::vector<std::string> order;
+  auto record = [&](std::string name) {
+    return [&, name] {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(name);
+    };
+  };
+
+  scheduler.Add("move", MakeAccess(0b10, 0b01), record("move"))
+      .Add("render", MakeAccess(0b01, 0), record("render"))
+      .Add("physics", MakeAccess(0, 0b10), record("physics"))
+      .Add("audio", MakeAccess(0b100, 0), record("audio"));
+  EXPECT_EQ(scheduler.GetDependencies(1), std::vector<size_t>{0});
+  EXPECT_EQ(scheduler.GetDependencies(2), std::vector<size_t>{0});
+  EXPECT_TRUE(scheduler.GetDependencies(3).empty());
+  EXPECT_EQ(scheduler.GetSystemName(2), "physics");
+
+  for (int run = 0; run < 50; ++run) {
+    order.clear();
+    scheduler.Run();
+    ASSERT_EQ(order.size(), 4);
+    auto position = [&order](const std::string& name) {
+      return std::find(order.begin(), order.end(), name) - order.begin();
+    };
+    EXPECT_LT(position("move"), position("render"));
+    EXPECT_LT(position("move"), position("physics"));
+  }
+}
+
+/**
+ * @brief Tests that systems without conflicts run at the same time.
+ */
+TEST_F(SchedulerTest, IndependentSystemsRunInParallel) {
+  ecs::Scheduler scheduler(2);
+  std::atomic<int> running = 0;
+  std::atomic<bool> overlapped = false;
+
+  // Each system waits until all three run at once, or gives up after a while
+  auto system = [&] {
+    ++running;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (running.load() < 3 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    if (running.load() == 3) {
+      overlapped = true;
+    }
+  };
+  scheduler.Add("npc", MakeAccess(0, 0b001), system)
+      .Add("economy", MakeAccess(0, 0b010), system)
+      .Add("weather", MakeAccess(0, 0b100), system);
+
+  scheduler.Run();
+  EXPECT_TRUE(overlapped);
+}
+
+/**
+ * @brief Tests that a scheduler without workers runs every system on the
+ * calling thread in the order they were added.
+ */
+TEST_F(SchedulerTest, NoWorkers) {
+  ecs::Scheduler scheduler(0);
+  EXPECT_EQ(scheduler.get_worker_count(), 0);
+
+  std::vector<int> order;
+  std::thread::id caller = std::this_thread::get_id();
+  for (int i = 0; i < 4; ++i) {
+    scheduler.Add("system", ecs::SystemAccess(), [&order, caller, i] {
+      EXPECT_EQ(std::this_thread::get_id(), caller);
+      order.push_back(i);
+    });
+  }
+
+  scheduler.Run().Run();
+  EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3, 0, 1, 2, 3}));
+}
+
+/**
+ * @brief Tests that schedulers can share a JobSystem and that Run() may be
+ * called from a task of that JobSystem.
+ */
+TEST_F(SchedulerTest, SharedJobSystem) {
+  tbge::jobs::JobSystem job_system(2);
+  ecs::Scheduler first(job_system);
+  ecs::Scheduler second(job_system);
+  EXPECT_EQ(first.get_worker_count(), 2);
+
+  std::atomic<int> count = 0;
+  for (int i = 0; i < 4; ++i) {
+    first.Add("first", MakeAccess(0, 1), [&count] { count.fetch_add(1); });
+    second.Add("second", MakeAccess(1, 0), [&count] { count.fetch_add(1); });
+  }
+
+  tbge::jobs::TaskGroup group(job_system);
+  group.Run([&first] { first.Run(); }).Run([&second] { second.Run(); });
+  group.Wait();
+  EXPECT_EQ(count.load(), 8);
+}
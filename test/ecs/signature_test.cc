@@ -0,0 +1,75 @@
+#include "src/ecs/signature/signature.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <unordered_set>
+
+/**
+ * @brief Tests a signature sized to a non-multiple of 64 bits.
+ */
+TEST(Signature, SetAndTest) {
+  ecs::BasicSignature<70> signature;
+  EXPECT_EQ(sizeof(signature), 16);
+  EXPECT_TRUE(signature.none());
+
+  signature.set(0).set(69).set(64, true);
+  signature[3] = true;
+  signature.reset(64);
+  EXPECT_TRUE(signature.test(0));
+  EXPECT_TRUE(signature[69]);
+  EXPECT_FALSE(signature.test(64));
+  EXPECT_EQ(signature.count(), 3);
+  EXPECT_EQ(signature.to_ulong(), 0b1001);
+
+  signature.reset();
+  EXPECT_FALSE(signature.any());
+
+  // Bits past the size are dropped, like std::bitset
+  EXPECT_EQ(ecs::BasicSignature<4>(0xFF).to_ulong(), 0xF);
+}
+
+/**
+ * @brief Tests the subset and intersection tests on the one word, two word
+ * and SIMD paths.
+ */
+template <size_t kBits>
+void TestIncludes() {
+  ecs::BasicSignature<kBits> entity;
+  ecs::BasicSignature<kBits> system;
+  EXPECT_TRUE(entity.includes(system));
+
+  system.set(1).set(kBits - 1);
+  EXPECT_FALSE(entity.includes(system));
+  entity.set(1);
+  EXPECT_FALSE(entity.includes(system));
+  entity.set(kBits - 1).set(kBits / 2);
+  EXPECT_TRUE(entity.includes(system));
+  EXPECT_FALSE(system.includes(entity));
+
+  EXPECT_TRUE(entity.intersects(system));
+  EXPECT_FALSE(entity.intersects(ecs::BasicSignature<kBits>().set(2)));
+  EXPECT_FALSE(entity.intersects(ecs::BasicSignature<kBits>()));
+
+  EXPECT_EQ((entity & system), system);
+  EXPECT_EQ((entity | system), entity);
+}
+
+TEST(Signature, Includes) {
+  TestIncludes<64>();
+  TestIncludes<128>();
+  TestIncludes<200>();
+  TestIncludes<1024>();
+}
+
+/**
+ * @brief Tests that equal signatures hash equally.
+ */
+TEST(Signature, Hash) {
+  std::unordered_set<ecs::BasicSignature<256>> signatures;
+  signatures.insert(ecs::BasicSignature<256>().set(200));
+  signatures.insert(ecs::BasicSignature<256>().set(200));
+  signatures.insert(ecs::BasicSignature<256>(1));
+  EXPECT_EQ(signatures.size(), 2);
+  EXPECT_TRUE(signatures.contains(ecs::BasicSignature<256>().set(200)));
+}
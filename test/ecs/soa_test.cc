@@ -0,0 +1,136 @@
+#include "src/ecs/component/soa.h"
+
+#include <absl/log/initialize.h>
+#include <absl/log/log_sink.h>
+#include <absl/log/log_sink_registry.h>
+#include <gtest/gtest.h>
+
+#include <span>
+#include <type_traits>
+
+#include "src/ecs/component_array/component_array.h"
+#include "src/ecs/component_array/soa_view.h"
+#include "src/ecs/coordinator/coordinator.h"
+#include "test/includes/test_log_sink.h"
+
+struct SoaVelocity {
+  float dx;
+  float dy;
+  int steps;
+};
+
+template <>
+struct ecs::SoaTraits<SoaVelocity> {
+  static constexpr auto kFields = std::make_tuple(
+      &SoaVelocity::dx, &SoaVelocity::dy, &SoaVelocity::steps);
+};
+
+static_assert(ecs::SoaComponent<SoaVelocity>);
+static_assert(std::is_same_v<ecs::ComponentReference<SoaVelocity>,
+                             ecs::SoaReference<SoaVelocity>>);
+static_assert(std::is_same_v<ecs::ComponentReference<int>, int&>);
+
+class SoaTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    absl::SetStderrThreshold(absl::LogSeverityAtLeast::kFatal);
+    test_sink_ = std::make_unique<TestLogSink>();
+    absl::AddLogSink(test_sink_.get());
+    test_sink_->Clear();
+  }
+
+  void TearDown() override {
+    absl::RemoveLogSink(test_sink_.get());
+    test_sink_->TestNoLogs("Tested in TearDown");
+  }
+
+  std::unique_ptr<TestLogSink> test_sink_;
+  ecs::ComponentArray<SoaVelocity> test_component_array;
+};
+
+/**
+ * @brief Tests that fields are read and written through the proxy reference.
+ */
+TEST_F(SoaTest, ProxyReference) {
+  test_component_array.InsertData(1, SoaVelocity{1.0f, 2.0f, 3});
+
+  ecs::SoaReference<SoaVelocity> velocity = test_component_array.GetData(1);
+  EXPECT_EQ(velocity.get<&SoaVelocity::dx>(), 1.0f);
+  EXPECT_EQ(velocity.get<1>(), 2.0f);
+
+  velocity.get<&SoaVelocity::steps>() += 4;
+  EXPECT_EQ(test_component_array.GetData(1).get<&SoaVelocity::steps>(), 7);
+
+  // Whole component reads and writes gather and scatter the fields
+  velocity = SoaVelocity{5.0f, 6.0f, 7};
+  SoaVelocity copy = test_component_array.GetData(1);
+  EXPECT_EQ(copy.dx, 5.0f);
+  EXPECT_EQ(copy.dy, 6.0f);
+  EXPECT_EQ(copy.steps, 7);
+}
+
+/**
+ * @brief Tests that each field is packed into its own column and that the
+ * columns stay parallel after a swap-remove.
+ */
+TEST_F(SoaTest, ColumnsStayPacked) {
+  test_component_array.InsertData(1, SoaVelocity{1.0f, 10.0f, 0});
+  test_component_array.InsertData(2, SoaVelocity{2.0f, 20.0f, 0});
+  test_component_array.InsertData(3, SoaVelocity{3.0f, 30.0f, 0});
+  test_component_array.RemoveData(1);
+
+  ecs::SoaView<SoaVelocity> view(test_component_array);
+  std::span<float> dx = view.column<&SoaVelocity::dx>();
+  std::span<float> dy = view.column<&SoaVelocity::dy>();
+  ASSERT_EQ(view.size(), 2);
+  ASSERT_EQ(dx.size(), 2);
+
+  for (size_t i = 0; i < view.size(); ++i) {
+    EXPECT_EQ(dy[i], dx[i] * 10.0f);
+    EXPECT_EQ(dx[i], static_cast<float>(view.entities()[i]));
+  }
+
+  for (float& value : dx) {
+    value *= 2.0f;
+  }
+  EXPECT_EQ(view[3].get<&SoaVelocity::dx>(), 6.0f);
+  EXPECT_EQ(view[3].get<&SoaVelocity::dy>(), 30.0f);
+}
+
+/**
+ * @brief Tests that the Coordinator hands out proxies for SoA components in
+ * both storage modes.
+ */
+TEST_F(SoaTest, Coordinator) {
+  for (ecs::StorageMode storage_mode :
+       {ecs::StorageMode::kComponentArrays, ecs::StorageMode::kArchetypes}) {
+    testing::internal::CaptureStdout();
+    ecs::Coordinator coordinator(storage_mode);
+    testing::internal::GetCapturedStdout();
+    test_sink_->Clear();
+
+    coordinator.RegisterComponentType<SoaVelocity>();
+    ecs::Entity entity = coordinator.CreateEntity();
+    coordinator.AddComponent<SoaVelocity>(entity, SoaVelocity{1.0f, 2.0f, 3});
+
+    auto velocity = coordinator.GetComponent<SoaVelocity>(entity);
+    velocity.get<&SoaVelocity::dx>() = 4.0f;
+    EXPECT_EQ(coordinator.GetComponent<SoaVelocity>(entity)
+                  .get<&SoaVelocity::dx>(),
+              4.0f);
+
+    int steps = 0;
+    coordinator.Each<SoaVelocity>(
+        [&steps](ecs::Entity, ecs::SoaReference<SoaVelocity> component) {
+          steps += component.get<&SoaVelocity::steps>();
+        });
+    EXPECT_EQ(steps, 3);
+  }
+
+  ecs::Coordinator coordinator;
+  test_sink_->Clear();
+  coordinator.RegisterComponentType<SoaVelocity>();
+  ecs::Entity entity = coordinator.CreateEntity();
+  coordinator.AddComponent<SoaVelocity>(entity, SoaVelocity{1.0f, 2.0f, 3});
+  EXPECT_EQ(coordinator.GetSoaView<SoaVelocity>().column<2>()[0], 3);
+}
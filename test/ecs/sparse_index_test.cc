@@ -0,0 +1,105 @@
+#include "src/ecs/sparse_index/sparse_index.h"
+
+#include <absl/log/initialize.h>
+#include <absl/log/log_sink.h>
+#include <absl/log/log_sink_registry.h>
+#include <gtest/gtest.h>
+
+#include "src/ecs/context/context.h"
+#include "test/includes/test_log_sink.h"
+
+class SparseIndexTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    test_sink_ = std::make_unique<TestLogSink>();
+    absl::AddLogSink(test_sink_.get());
+    test_sink_->Clear();
+  }
+
+  void TearDown() override {
+    absl::RemoveLogSink(test_sink_.get());
+    test_sink_->TestNoLogs();
+  }
+
+  std::unique_ptr<TestLogSink> test_sink_;
+  ecs::SparseIndex test_sparse_index;
+  static constexpr ecs::Entity kPageSize = ecs::SparseIndex::kPageSize;
+};
+
+/**
+ * @brief Tests that stored indices are returned and missing ones are invalid.
+ */
+TEST_F(SparseIndexTest, SetAndGet) {
+  EXPECT_EQ(test_sparse_index.Get(1), ecs::SparseIndex::kInvalidIndex);
+  EXPECT_FALSE(test_sparse_index.Contains(1));
+
+  test_sparse_index.Set(1, 10);
+  test_sparse_index.Set(2, 20);
+
+  EXPECT_EQ(test_sparse_index.Get(1), 10);
+  EXPECT_EQ(test_sparse_index.Get(2), 20);
+  EXPECT_TRUE(test_sparse_index.Contains(1));
+  EXPECT_FALSE(test_sparse_index.Contains(3));
+
+  test_sparse_index.Set(1, 30);
+  EXPECT_EQ(test_sparse_index.Get(1), 30);
+}
+
+/**
+ * @brief Tests that pages are only allocated for populated entity ranges.
+ *
+ * @details
+ * Entities far apart in the ID range should allocate one page each, without
+ * allocating the pages in between.
+ */
+TEST_F(SparseIndexTest, AllocatesPagesOnDemand) {
+  EXPECT_EQ(test_sparse_index.get_page_count(), 0);
+
+  test_sparse_index.Set(0, 0);
+  test_sparse_index.Set(1, 1);
+  EXPECT_EQ(test_sparse_index.get_page_count(), 1);
+
+  test_sparse_index.Set(kPageSize * 100, 2);
+  EXPECT_EQ(test_sparse_index.get_page_count(), 2);
+  EXPECT_EQ(test_sparse_index.get_directory_size(), 101);
+  EXPECT_EQ(test_sparse_index.Get(kPageSize * 100), 2);
+  EXPECT_FALSE(test_sparse_index.Contains(kPageSize * 50));
+}
+
+/**
+ * @brief Tests that pages are freed once their last entity is erased.
+ *
+ * @details
+ * Erasing the only entity of the highest page should free that page and
+ * shrink the page directory back to the highest populated page.
+ */
+TEST_F(SparseIndexTest, FreesEmptyPages) {
+  test_sparse_index.Set(0, 0);
+  test_sparse_index.Set(kPageSize * 10, 1);
+  test_sparse_index.Set(kPageSize * 10 + 1, 2);
+  EXPECT_EQ(test_sparse_index.get_page_count(), 2);
+
+  test_sparse_index.Erase(kPageSize * 10);
+  EXPECT_EQ(test_sparse_index.get_page_count(), 2);
+
+  test_sparse_index.Erase(kPageSize * 10 + 1);
+  EXPECT_EQ(test_sparse_index.get_page_count(), 1);
+  EXPECT_EQ(test_sparse_index.get_directory_size(), 1);
+
+  // Erasing an entity without an index is a no-op
+  test_sparse_index.Erase(kPageSize * 10);
+  test_sparse_index.Erase(5);
+  EXPECT_EQ(test_sparse_index.get_page_count(), 1);
+
+  test_sparse_index.Erase(0);
+  EXPECT_EQ(test_sparse_index.get_page_count(), 0);
+  EXPECT_EQ(test_sparse_index.get_directory_size(), 0);
+}
+
+/**
+ * @brief Tests that storing the invalid index triggers a fatal check.
+ */
+TEST_F(SparseIndexTest, SetInvalidIndex) {
+  EXPECT_DEATH(test_sparse_index.Set(1, ecs::SparseIndex::kInvalidIndex),
+               "Attempted to store the invalid index for Entity ID .*.");
+}
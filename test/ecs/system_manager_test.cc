@@ -5,6 +5,8 @@
 #include <absl/log/log_sink_registry.h>
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "test/includes/test_log_sink.h"
 
 class SystemManagerTest : public ::testing::Test {
@@ -35,6 +37,11 @@ class DummySystem2 : public ecs::System {
   DummySystem2() = default;
 };
 
+class DummySystem3 : public ecs::System {
+ public:
+  DummySystem3() = default;
+};
+
 TEST_F(SystemManagerTest, RegisterSystem) {
   EXPECT_NE(test_system_manager.RegisterSystem<DummySystem>(), nullptr);
   EXPECT_EQ(test_system_manager.get_systems().size(), 1);
@@ -58,12 +65,12 @@ TEST_F(SystemManagerTest, SetSignature) {
   test_system_manager.SetSignature<DummySystem>(ecs::Signature(2));
 
   EXPECT_EQ(test_system_manager.get_signatures().size(), 1);
-  EXPECT_EQ(test_system_manager.get_signatures().begin()->second.to_ulong(), 2);
+  EXPECT_EQ(test_system_manager.get_signatures().front().to_ulong(), 2);
 
   test_system_manager.SetSignature<DummySystem>(ecs::Signature(4));
 
   EXPECT_EQ(test_system_manager.get_signatures().size(), 1);
-  EXPECT_EQ(test_system_manager.get_signatures().begin()->second.to_ulong(), 4);
+  EXPECT_EQ(test_system_manager.get_signatures().front().to_ulong(), 4);
 }
 
 TEST_F(SystemManagerTest, SetSignatureOnUnregisteredSystem) {
@@ -245,3 +252,117 @@ TEST_F(SystemManagerTest, EntitySignatureNoSystemsRegistered) {
   EXPECT_EQ(test_system_manager.get_signatures().size(), 0)
       << "No signatures should be affected";
 }
+
+TEST_F(SystemManagerTest, EntitiesSignatureChanged) {
+  auto system = test_system_manager.RegisterSystem<DummySystem>();
+  test_system_manager.SetSignature<DummySystem>(ecs::Signature(0b10));
+  test_system_manager.EntitySignatureChanged(3, ecs::Signature(0b10));
+
+  std::vector<ecs::Entity> entities{1, 2, 3};
+  std::vector<ecs::Signature> signatures{
+      ecs::Signature(0b10), ecs::Signature(0b11), ecs::Signature(0b01)};
+  test_system_manager.EntitiesSignatureChanged(entities, signatures);
+
+  EXPECT_TRUE(system->has_entity(1));
+  EXPECT_TRUE(system->has_entity(2));
+  EXPECT_FALSE(system->has_entity(3));
+}
+
+TEST_F(SystemManagerTest, SignatureChangedOnlyUpdatesSystemsOfChangedType) {
+  auto position_system = test_system_manager.RegisterSystem<DummySystem>();
+  auto velocity_system = test_system_manager.RegisterSystem<DummySystem2>();
+  auto unfiltered_system = test_system_manager.RegisterSystem<DummySystem3>();
+  test_system_manager.SetSignature<DummySystem>(ecs::Signature(0b01));
+  test_system_manager.SetSignature<DummySystem2>(ecs::Signature(0b10));
+
+  // Systems that do not include the changed type are left alone
+  test_system_manager.EntitySignatureChanged(1, ecs::Signature(0b11), 0);
+  EXPECT_TRUE(position_system->has_entity(1));
+  EXPECT_FALSE(velocity_system->has_entity(1));
+  EXPECT_TRUE(unfiltered_system->has_entity(1));
+
+  std::vector<ecs::Entity> entities{1, 2};
+  std::vector<ecs::Signature> signatures{ecs::Signature(0b10),
+                                         ecs::Signature(0b11)};
+  std::vector<ecs::ComponentTypeId> changed_types{0, 1};
+  test_system_manager.EntitiesSignatureChanged(entities, signatures,
+                                               changed_types);
+  EXPECT_FALSE(position_system->has_entity(1));
+  EXPECT_TRUE(position_system->has_entity(2));
+  EXPECT_TRUE(velocity_system->has_entity(1));
+  EXPECT_TRUE(velocity_system->has_entity(2));
+
+  // Replacing a signature moves the system to the new types
+  test_system_manager.SetSignature<DummySystem>(ecs::Signature(0b100));
+  test_system_manager.EntitySignatureChanged(3, ecs::Signature(0b101), 0);
+  EXPECT_FALSE(position_system->has_entity(3));
+  test_system_manager.EntitySignatureChanged(3, ecs::Signature(0b101), 2);
+  EXPECT_TRUE(position_system->has_entity(3));
+  EXPECT_FALSE(velocity_system->has_entity(3));
+}
+
+TEST_F(SystemManagerTest, ExcludedSignature) {
+  auto system = test_system_manager.RegisterSystem<DummySystem>();
+  auto unfiltered_system = test_system_manager.RegisterSystem<DummySystem2>();
+  test_system_manager.SetSignature<DummySystem>(ecs::Signature(0b001))
+      .SetExcludedSignature<DummySystem>(ecs::Signature(0b100));
+  EXPECT_EQ(test_system_manager.GetExcludedSignature<DummySystem>(),
+            ecs::Signature(0b100));
+  EXPECT_EQ(test_system_manager.GetExcludedSignature<DummySystem2>(),
+            ecs::Signature());
+
+  test_system_manager.EntitySignatureChanged(1, ecs::Signature(0b011), 0);
+  test_system_manager.EntitySignatureChanged(2, ecs::Signature(0b101), 0);
+  EXPECT_TRUE(system->has_entity(1));
+  EXPECT_FALSE(system->has_entity(2));
+
+  // Changes of an excluded type reach the system through the index
+  test_system_manager.EntitySignatureChanged(1, ecs::Signature(0b111), 2);
+  EXPECT_FALSE(system->has_entity(1));
+  test_system_manager.EntitySignatureChanged(2, ecs::Signature(0b001), 2);
+  EXPECT_TRUE(system->has_entity(2));
+
+  // Optional types do not change which entities match
+  test_system_manager.SetOptionalSignature<DummySystem>(ecs::Signature(0b010));
+  test_system_manager.EntitySignatureChanged(2, ecs::Signature(0b011), 1);
+  EXPECT_TRUE(system->has_entity(2));
+  EXPECT_EQ(test_system_manager.get_optional_signatures().front(),
+            ecs::Signature(0b010));
+  EXPECT_TRUE(unfiltered_system->has_entity(1));
+}
+
+/**
+ * @brief Tests that a system with only an excluded signature sees changes of
+ * every type, as any of them can let an entity in.
+ */
+TEST_F(SystemManagerTest, ExcludedSignatureOnly) {
+  auto system = test_system_manager.RegisterSystem<DummySystem>();
+  test_system_manager.SetSignature<DummySystem>(ecs::Signature())
+      .SetExcludedSignature<DummySystem>(ecs::Signature(0b100));
+
+  test_system_manager.EntitySignatureChanged(1, ecs::Signature(0b001), 0);
+  EXPECT_TRUE(system->has_entity(1));
+  test_system_manager.EntitySignatureChanged(1, ecs::Signature(0b101), 2);
+  EXPECT_FALSE(system->has_entity(1));
+
+  std::vector<ecs::Entity> entities{2};
+  std::vector<ecs::Signature> signatures{ecs::Signature(0b010)};
+  std::vector<ecs::ComponentTypeId> changed_types{1};
+  test_system_manager.EntitiesSignatureChanged(entities, signatures,
+                                               changed_types);
+  EXPECT_TRUE(system->has_entity(2));
+
+  // Requiring a type again limits the system to the indexed types
+  test_system_manager.SetSignature<DummySystem>(ecs::Signature(0b001));
+  test_system_manager.EntitySignatureChanged(3, ecs::Signature(0b001), 1);
+  EXPECT_FALSE(system->has_entity(3));
+  test_system_manager.EntitySignatureChanged(3, ecs::Signature(0b001), 0);
+  EXPECT_TRUE(system->has_entity(3));
+}
+
+TEST_F(SystemManagerTest, SetExcludedSignatureOnUnregisteredSystem) {
+  test_system_manager.SetExcludedSignature<DummySystem>(ecs::Signature(1));
+  test_sink_->TestLogs(absl::LogSeverity::kError,
+                       "Attempted to set excluded signature on system of "
+                       "typename .* before it was registered");
+}
@@ -6,9 +6,9 @@
 #include <gtest/gtest.h>
 
 #include <iostream>
-#include <set>
 
 #include "src/ecs/context/context.h"
+#include "src/ecs/entity_set/entity_set.h"
 #include "test/includes/test_log_sink.h"
 
 class SystemTest : public ::testing::Test {
@@ -57,4 +57,46 @@ TEST_F(SystemTest, HasEntityAfterConstruction) {
   EXPECT_FALSE(test_system.has_entity(1));
   EXPECT_FALSE(test_system.has_entity(2));
   EXPECT_FALSE(test_system.has_entity(3));
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Test that set_entities only notifies about entities that change.
+ */
+TEST_F(SystemTest, SetEntities) {
+  class CountingSystem : public ecs::System {
+   public:
+    using ecs::System::set_entities;
+
+    int added = 0;
+    int removed = 0;
+
+   protected:
+    System& add_entity(ecs::Entity) override {
+      ++added;
+      return *this;
+    }
+
+    System& remove_entity(ecs::Entity) override {
+      ++removed;
+      return *this;
+    }
+  };
+
+  CountingSystem system;
+  ecs::EntitySet entities;
+  for (ecs::Entity entity : {1, 2, 3, 4}) {
+    entities.insert(entity);
+  }
+  system.set_entities(entities);
+  EXPECT_EQ(system.added, 4);
+
+  entities.erase(1);
+  entities.erase(3);
+  entities.insert(5);
+  system.set_entities(entities);
+  EXPECT_EQ(system.added, 5);
+  EXPECT_EQ(system.removed, 2);
+  EXPECT_EQ(system.get_entities().size(), 3);
+  EXPECT_FALSE(system.has_entity(1));
+  EXPECT_TRUE(system.has_entity(5));
+}
@@ -0,0 +1,180 @@
+#include "src/ecs/component/tag.h"
+
+#include <absl/log/initialize.h>
+#include <absl/log/log_sink.h>
+#include <absl/log/log_sink_registry.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "src/ecs/component/soa.h"
+#include "src/ecs/coordinator/coordinator.h"
+#include "test/includes/test_log_sink.h"
+
+struct TagPosition {
+  int x;
+};
+
+struct Visible {};
+
+struct Frozen {};
+
+static_assert(ecs::TagComponent<Visible>);
+static_assert(!ecs::TagComponent<TagPosition>);
+static_assert(std::is_same_v<ecs::ComponentReference<Visible>, Visible>);
+static_assert(
+    std::is_same_v<ecs::tag_internal::WithoutTags<Visible, TagPosition, Frozen>,
+                   std::tuple<TagPosition>>);
+
+class TagSystem : public ecs::System {};
+
+class TagTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    absl::SetStderrThreshold(absl::LogSeverityAtLeast::kFatal);
+    test_sink_ = std::make_unique<TestLogSink>();
+    absl::AddLogSink(test_sink_.get());
+    test_sink_->Clear();
+  }
+
+  void TearDown() override {
+    absl::RemoveLogSink(test_sink_.get());
+    test_sink_->TestNoLogs("Tested in TearDown");
+  }
+
+  /// @brief Creates nine entities with a position, tagging every third one as
+  /// visible.
+  std::unique_ptr<ecs::Coordinator> MakeCoordinator(
+      ecs::StorageMode storage_mode) {
+    testing::internal::CaptureStdout();
+    auto coordinator = std::make_unique<ecs::Coordinator>(storage_mode);
+    testing::internal::GetCapturedStdout();
+    coordinator->RegisterComponentType<TagPosition>();
+    coordinator->RegisterComponentType<Visible>();
+    coordinator->RegisterComponentType<Frozen>();
+    test_sink_->Clear();
+
+    visible_entities.clear();
+    for (int i = 0; i < 9; ++i) {
+      ecs::Entity entity = coordinator->CreateEntity();
+      coordinator->AddComponent<TagPosition>(entity, TagPosition{i});
+      if (i % 3 == 0) {
+        coordinator->AddComponent<Visible>(entity, Visible{});
+        visible_entities.push_back(entity);
+      }
+    }
+
+    return coordinator;
+  }
+
+  std::unique_ptr<TestLogSink> test_sink_;
+  std::vector<ecs::Entity> visible_entities;
+};
+
+/**
+ * @brief Tests adding and removing a tag.
+ */
+TEST_F(TagTest, AddAndRemove) {
+  for (ecs::StorageMode storage_mode :
+       {ecs::StorageMode::kComponentArrays, ecs::StorageMode::kArchetypes}) {
+    auto coordinator = MakeCoordinator(storage_mode);
+    ecs::Entity entity = visible_entities[1];
+
+    EXPECT_TRUE(coordinator->HasComponent<Visible>(entity));
+    EXPECT_FALSE(coordinator->HasComponent<Frozen>(entity));
+    coordinator->GetComponent<Visible>(entity);
+
+    coordinator->RemoveComponent<Visible>(entity);
+    EXPECT_FALSE(coordinator->HasComponent<Visible>(entity));
+
+    // The data components are untouched
+    EXPECT_EQ(coordinator->GetComponent<TagPosition>(entity).x, 3);
+  }
+}
+
+/**
+ * @brief Tests that retrieving a tag the entity does not have aborts.
+ */
+TEST_F(TagTest, GetMissingTag) {
+  auto coordinator = MakeCoordinator(ecs::StorageMode::kComponentArrays);
+
+  EXPECT_DEATH(coordinator->GetComponent<Frozen>(visible_entities[0]),
+               "Retrieving non-existent component");
+}
+
+/**
+ * @brief Tests that systems match entities on their tags.
+ */
+TEST_F(TagTest, SystemSignature) {
+  testing::internal::CaptureStdout();
+  ecs::Coordinator coordinator;
+  testing::internal::GetCapturedStdout();
+  coordinator.RegisterComponentType<TagPosition>();
+  coordinator.RegisterComponentType<Visible>();
+  test_sink_->Clear();
+
+  auto system = coordinator.RegisterSystem<TagSystem>();
+  ecs::Signature signature;
+  signature.set(coordinator.GetComponentTypeId<TagPosition>(), true);
+  signature.set(coordinator.GetComponentTypeId<Visible>(), true);
+  coordinator.SetSystemSignature<TagSystem>(signature);
+
+  ecs::Entity entity = coordinator.CreateEntity();
+  coordinator.AddComponent<TagPosition>(entity, TagPosition{0});
+  EXPECT_FALSE(system->has_entity(entity));
+  coordinator.AddComponent<Visible>(entity, Visible{});
+  EXPECT_TRUE(system->has_entity(entity));
+  coordinator.RemoveComponent<Visible>(entity);
+  EXPECT_FALSE(system->has_entity(entity));
+}
+
+/**
+ * @brief Tests that tags filter the entities visited by a View.
+ */
+TEST_F(TagTest, View) {
+  auto coordinator = MakeCoordinator(ecs::StorageMode::kComponentArrays);
+
+  std::vector<ecs::Entity> visited;
+  for (auto [entity, position, visible] :
+       coordinator->View<TagPosition, Visible>()) {
+    EXPECT_EQ(position.x, static_cast<int>(entity));
+    visited.push_back(entity);
+  }
+  EXPECT_EQ(visited, visible_entities);
+
+  auto view = coordinator->View<Visible, TagPosition>();
+  EXPECT_TRUE(view.Contains(visible_entities[2]));
+  EXPECT_FALSE(view.Contains(visible_entities[2] + 1));
+
+  int count = 0;
+  coordinator->View<TagPosition, Frozen>().each(
+      [&count](ecs::Entity, TagPosition&, Frozen) { ++count; });
+  EXPECT_EQ(count, 0);
+}
+
+/**
+ * @brief Tests that tags filter Each in both storage modes.
+ */
+TEST_F(TagTest, Each) {
+  for (ecs::StorageMode storage_mode :
+       {ecs::StorageMode::kComponentArrays, ecs::StorageMode::kArchetypes}) {
+    auto coordinator = MakeCoordinator(storage_mode);
+
+    std::vector<ecs::Entity> visited;
+    coordinator->Each<Visible, TagPosition>(
+        [&visited](ecs::Entity entity, Visible, TagPosition& position) {
+          position.x = -1;
+          visited.push_back(entity);
+        });
+    std::sort(visited.begin(), visited.end());
+    EXPECT_EQ(visited, visible_entities);
+
+    for (ecs::Entity entity : visible_entities) {
+      EXPECT_EQ(coordinator->GetComponent<TagPosition>(entity).x, -1);
+    }
+  }
+}
@@ -0,0 +1,33 @@
+#include "src/ecs/type_index/type_index.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+struct FirstFamily;
+struct SecondFamily;
+
+using FirstIndex = ecs::TypeIndex<FirstFamily>;
+using SecondIndex = ecs::TypeIndex<SecondFamily>;
+
+}  // namespace
+
+TEST(TypeIndexTest, IndicesAreDenseAndStable) {
+  size_t int_index = FirstIndex::Get<int>();
+  size_t float_index = FirstIndex::Get<float>();
+
+  EXPECT_NE(int_index, float_index);
+  EXPECT_EQ(FirstIndex::Get<int>(), int_index);
+  EXPECT_EQ(FirstIndex::Get<float>(), float_index);
+  EXPECT_LT(int_index, FirstIndex::get_count());
+  EXPECT_LT(float_index, FirstIndex::get_count());
+  EXPECT_EQ(FirstIndex::get_count(), 2);
+}
+
+TEST(TypeIndexTest, FamiliesAreIndependent) {
+  size_t double_index = SecondIndex::Get<double>();
+  size_t char_index = SecondIndex::Get<char>();
+
+  EXPECT_EQ(double_index + char_index, 1);
+  EXPECT_EQ(SecondIndex::get_count(), 2);
+}
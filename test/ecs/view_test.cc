@@ -0,0 +1,116 @@
+#include "src/ecs/view/view.h"
+
+#include <absl/log/initialize.h>
+#include <absl/log/log_sink.h>
+#include <absl/log/log_sink_registry.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "src/ecs/coordinator/coordinator.h"
+#include "test/includes/test_log_sink.h"
+
+struct ViewPosition {
+  int x;
+};
+
+struct ViewVelocity {
+  int dx;
+};
+
+class ViewTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    absl::SetStderrThreshold(absl::LogSeverityAtLeast::kFatal);
+    test_sink_ = std::make_unique<TestLogSink>();
+    absl::AddLogSink(test_sink_.get());
+
+    testing::internal::CaptureStdout();
+    test_coordinator = std::make_unique<ecs::Coordinator>();
+    testing::internal::GetCapturedStdout();
+    test_coordinator->RegisterComponentType<ViewPosition>();
+    test_coordinator->RegisterComponentType<ViewVelocity>();
+    test_sink_->Clear();
+
+    // Every entity has a position, every third one also a velocity
+    for (int i = 0; i < 9; ++i) {
+      ecs::Entity entity = test_coordinator->CreateEntity();
+      test_coordinator->AddComponent<ViewPosition>(entity, ViewPosition{i});
+      if (i % 3 == 0) {
+        test_coordinator->AddComponent<ViewVelocity>(entity, ViewVelocity{10});
+        moving_entities.push_back(entity);
+      }
+    }
+  }
+
+  void TearDown() override {
+    absl::RemoveLogSink(test_sink_.get());
+    test_sink_->TestNoLogs("Tested in TearDown");
+  }
+
+  std::unique_ptr<TestLogSink> test_sink_;
+  std::unique_ptr<ecs::Coordinator> test_coordinator;
+  std::vector<ecs::Entity> moving_entities;
+};
+
+/**
+ * @brief Tests iterating a view with structured bindings.
+ *
+ * @details
+ * Only entities with both components are visited, the yielded components are
+ * references into the pools, and the smallest pool drives the iteration.
+ */
+TEST_F(ViewTest, RangeBasedFor) {
+  ecs::View<ViewPosition, ViewVelocity> view =
+      test_coordinator->View<ViewPosition, ViewVelocity>();
+  EXPECT_EQ(view.get_size_hint(), moving_entities.size());
+
+  std::vector<ecs::Entity> visited;
+  for (auto [entity, position, velocity] : view) {
+    position.x += velocity.dx;
+    visited.push_back(entity);
+  }
+
+  EXPECT_EQ(visited, moving_entities);
+  for (ecs::Entity entity : moving_entities) {
+    EXPECT_EQ(test_coordinator->GetComponent<ViewPosition>(entity).x,
+              static_cast<int>(entity) + 10);
+  }
+  EXPECT_EQ(test_coordinator->GetComponent<ViewPosition>(1).x, 1);
+}
+
+/**
+ * @brief Tests that each() visits the same entities as the iterator.
+ */
+TEST_F(ViewTest, Each) {
+  test_coordinator->RemoveComponent<ViewVelocity>(moving_entities.front());
+
+  int visited = 0;
+  test_coordinator->View<ViewVelocity, ViewPosition>().each(
+      [&](ecs::Entity entity, ViewVelocity& velocity, ViewPosition& position) {
+        EXPECT_NE(entity, moving_entities.front());
+        EXPECT_EQ(velocity.dx, 10);
+        EXPECT_EQ(position.x, static_cast<int>(entity));
+        ++visited;
+      });
+  EXPECT_EQ(visited, moving_entities.size() - 1);
+
+  auto view = test_coordinator->View<ViewPosition, ViewVelocity>();
+  EXPECT_FALSE(view.Contains(moving_entities.front()));
+  EXPECT_TRUE(view.Contains(moving_entities.back()));
+}
+
+/**
+ * @brief Tests a view where no entity has every component.
+ */
+TEST_F(ViewTest, EmptyView) {
+  struct Unused {
+    int value;
+  };
+  test_coordinator->RegisterComponentType<Unused>();
+
+  auto view = test_coordinator->View<ViewPosition, Unused>();
+  EXPECT_EQ(view.begin(), view.end());
+  EXPECT_EQ(view.get_size_hint(), 0);
+}
@@ -0,0 +1,175 @@
+#include "src/engine/world.h"
+
+#include <absl/log/initialize.h>
+#include <absl/log/log_sink.h>
+#include <absl/log/log_sink_registry.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "src/ecs/scheduler/scheduler.h"
+#include "test/includes/test_log_sink.h"
+
+class WorldTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    absl::SetStderrThreshold(absl::LogSeverityAtLeast::kFatal);
+    test_sink_ = std::make_unique<TestLogSink>();
+    absl::AddLogSink(test_sink_.get());
+
+    testing::internal::CaptureStdout();
+    test_world = std::make_unique<tbge::engine::World>(2);
+    testing::internal::GetCapturedStdout();
+    test_sink_->Clear();
+  }
+
+  void TearDown() override {
+    absl::RemoveLogSink(test_sink_.get());
+    test_sink_->TestNoLogs("Tested in TearDown");
+  }
+
+  std::unique_ptr<TestLogSink> test_sink_;
+  std::unique_ptr<tbge::engine::World> test_world;
+};
+
+/**
+ * @brief Tests that Step() updates every system with the timestep.
+ */
+TEST_F(WorldTest, Step) {
+  test_world->set_timestep(std::chrono::milliseconds(10));
+
+  int exclusive_steps = 0;
+  std::atomic<int> parallel_steps = 0;
+  test_world
+      ->AddSystem("exclusive",
+                  [&exclusive_steps](tbge::engine::World::Duration timestep) {
+                    EXPECT_EQ(timestep, std::chrono::milliseconds(10));
+                    ++exclusive_steps;
+                  })
+      .AddSystem("parallel", ecs::SystemAccess(),
+                 [&parallel_steps](tbge::engine::World::Duration) {
+                   parallel_steps.fetch_add(1);
+                 });
+
+  test_world->Step().Step();
+  EXPECT_EQ(exclusive_steps, 2);
+  EXPECT_EQ(parallel_steps.load(), 2);
+  EXPECT_EQ(test_world->get_step_count(), 2);
+}
+
+/**
+ * @brief Tests that a real-time Run() steps at the timestep until a system
+ * stops it, with every pacing.
+ */
+TEST_F(WorldTest, RealTime) {
+  constexpr auto kTimestep = std::chrono::milliseconds(2);
+  test_world->set_timestep(kTimestep);
+
+  size_t steps = 0;
+  test_world->AddSystem("stop", [this, &steps](tbge::engine::World::Duration) {
+    if (++steps % 10 == 0) {
+      test_world->Stop();
+    }
+  });
+
+  for (tbge::engine::Pacing pacing :
+       {tbge::engine::Pacing::kSleep, tbge::engine::Pacing::kHybrid,
+        tbge::engine::Pacing::kSpin}) {
+    test_world->set_pacing(pacing);
+    auto start = tbge::engine::World::Clock::now();
+    size_t steps_before = test_world->get_step_count();
+    test_world->Run();
+
+    // The first step is due one timestep after Run() starts
+    EXPECT_GE(tbge::engine::World::Clock::now() - start, kTimestep * 10);
+    EXPECT_EQ(test_world->get_step_count(), steps_before + 10);
+  }
+  EXPECT_EQ(steps, 30);
+}
+
+/**
+ * @brief Tests that a slow step makes the next frame catch up by at most
+ * get_max_steps_per_frame() steps, and that the rest is dropped.
+ */
+TEST_F(WorldTest, CatchUpCap) {
+  test_world->set_timestep(std::chrono::milliseconds(1))
+      .set_max_steps_per_frame(3);
+
+  size_t steps = 0;
+  test_world->AddSystem("slow", [this, &steps](tbge::engine::World::Duration) {
+    if (++steps == 1) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    } else if (steps == 5) {
+      // The first step after the catch-up frame
+      test_world->Stop();
+    }
+  });
+  test_world->Run();
+
+  EXPECT_EQ(test_world->get_step_count(), 5);
+  EXPECT_GE(test_world->get_dropped_step_count(), 15);
+}
+
+/**
+ * @brief Tests that a Stop() during a catch-up does not count the steps that
+ * were left as dropped.
+ */
+TEST_F(WorldTest, StopDuringCatchUp) {
+  test_world->set_timestep(std::chrono::milliseconds(1))
+      .set_max_steps_per_frame(3);
+
+  size_t steps = 0;
+  test_world->AddSystem("slow", [this, &steps](tbge::engine::World::Duration) {
+    if (++steps == 1) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    } else if (steps == 2) {
+      test_world->Stop();
+    }
+  });
+  test_world->Run();
+
+  EXPECT_EQ(test_world->get_step_count(), 2);
+  EXPECT_EQ(test_world->get_dropped_step_count(), 0);
+}
+
+/**
+ * @brief Tests that a turn-based Run() takes one step per turn and waits for
+ * turns otherwise.
+ */
+TEST_F(WorldTest, TurnBased) {
+  test_world->set_mode(tbge::engine::StepMode::kTurnBased);
+  test_world->AddSystem("turn", [](tbge::engine::World::Duration) {});
+
+  test_world->AdvanceTurn(2);
+  std::thread loop([this] { test_world->Run(); });
+
+  while (test_world->get_step_count() < 2) {
+    std::this_thread::yield();
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(test_world->get_step_count(), 2);
+
+  test_world->AdvanceTurn();
+  while (test_world->get_step_count() < 3) {
+    std::this_thread::yield();
+  }
+  test_world->Stop();
+  loop.join();
+  EXPECT_EQ(test_world->get_step_count(), 3);
+}
+
+/**
+ * @brief Tests that Stop() before Run() makes it return without stepping.
+ */
+TEST_F(WorldTest, StopBeforeRun) {
+  test_world->set_mode(tbge::engine::StepMode::kTurnBased);
+  test_world->Stop().Run();
+  EXPECT_EQ(test_world->get_step_count(), 0);
+
+  test_world->set_mode(tbge::engine::StepMode::kRealTime);
+  test_world->Stop().Run();
+  EXPECT_EQ(test_world->get_step_count(), 0);
+}
@@ -0,0 +1,197 @@
+#include "src/jobs/job_system.h"
+
+#include <absl/log/initialize.h>
+#include <absl/log/log_sink.h>
+#include <absl/log/log_sink_registry.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "src/jobs/work_stealing_deque.h"
+#include "test/includes/test_log_sink.h"
+
+class JobSystemTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    test_sink_ = std::make_unique<TestLogSink>();
+    absl::AddLogSink(test_sink_.get());
+    test_sink_->Clear();
+  }
+
+  void TearDown() override {
+    absl::RemoveLogSink(test_sink_.get());
+    test_sink_->TestNoLogs();
+  }
+
+  std::unique_ptr<TestLogSink> test_sink_;
+};
+
+/**
+ * @brief Tests that the owner pops the newest item, thieves take the oldest,
+ * and the deque grows past its initial capacity.
+ */
+TEST_F(JobSystemTest, WorkStealingDeque) {
+  tbge::jobs::WorkStealingDeque<int*> deque(2);
+  std::vector<int> items(5);
+  EXPECT_EQ(deque.Pop(), nullptr);
+  EXPECT_EQ(deque.Steal(), nullptr);
+
+  for (int& item : items) {
+    deque.Push(&item);
+  }
+  EXPECT_EQ(deque.get_size(), 5);
+
+  EXPECT_EQ(deque.Pop(), &items[4]);
+  EXPECT_EQ(deque.Steal(), &items[0]);
+  EXPECT_EQ(deque.Steal(), &items[1]);
+  EXPECT_EQ(deque.Pop(), &items[3]);
+  EXPECT_EQ(deque.Pop(), &items[2]);
+  EXPECT_EQ(deque.Pop(), nullptr);
+  EXPECT_EQ(deque.get_size(), 0);
+}
+
+/**
+ * @brief Tests that every item is taken exactly once while thieves race the
+ * owner.
+ */
+TEST_F(JobSystemTest, ConcurrentSteal) {
+  constexpr size_t kItemCount = 100000;
+  constexpr size_t kThiefCount = 3;
+
+  tbge::jobs::WorkStealingDeque<size_t*> deque(4);
+  std::vector<size_t> items(kItemCount);
+  std::vector<std::atomic<int>> taken(kItemCount);
+  std::atomic<bool> done = false;
+
+  auto take = [&](size_t* item) { taken[*item].fetch_add(1); };
+
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < kThiefCount; ++i) {
+    thieves.emplace_back([&] {
+      while (!done.load()) {
+        if (size_t* item = deque.Steal()) {
+          take(item);
+        }
+      }
+    });
+  }
+
+  for (size_t i = 0; i < kItemCount; ++i) {
+    items[i] = i;
+    deque.Push(&items[i]);
+    if (i % 3 == 0) {
+      if (size_t* item = deque.Pop()) {
+        take(item);
+      }
+    }
+  }
+  while (size_t* item = deque.Pop()) {
+    take(item);
+  }
+  done.store(true);
+  for (std::thread& thief : thieves) {
+    thief.join();
+  }
+
+  for (size_t i = 0; i < kItemCount; ++i) {
+    EXPECT_EQ(taken[i].load(), 1) << "Item " << i;
+  }
+}
+
+/**
+ * @brief Tests that Wait() returns once every task finished, including tasks
+ * queued by other tasks.
+ */
+TEST_F(JobSystemTest, TaskGroup) {
+  tbge::jobs::JobSystem job_system(3);
+  EXPECT_EQ(job_system.get_worker_count(), 3);
+  EXPECT_EQ(job_system.get_current_worker(),
+            tbge::jobs::JobSystem::kNotAWorker);
+
+  std::atomic<int> count = 0;
+  tbge::jobs::TaskGroup group(job_system);
+  for (int i = 0; i < 100; ++i) {
+    group.Run([&] {
+      count.fetch_add(1);
+      group.Run([&] { count.fetch_add(1); });
+    });
+  }
+  group.Wait();
+
+  EXPECT_EQ(count.load(), 200);
+  EXPECT_EQ(group.get_pending_count(), 0);
+}
+
+/**
+ * @brief Tests that tasks may wait for groups of their own without
+ * deadlocking, even with a single worker.
+ */
+TEST_F(JobSystemTest, NestedWait) {
+  tbge::jobs::JobSystem job_system(1);
+
+  std::atomic<int> count = 0;
+  tbge::jobs::TaskGroup outer(job_system);
+  for (int i = 0; i < 8; ++i) {
+    outer.Run([&] {
+      tbge::jobs::TaskGroup inner(job_system);
+      for (int j = 0; j < 8; ++j) {
+        inner.Run([&] { count.fetch_add(1); });
+      }
+      inner.Wait();
+      EXPECT_EQ(inner.get_pending_count(), 0);
+    });
+  }
+  outer.Wait();
+
+  EXPECT_EQ(count.load(), 64);
+}
+
+/**
+ * @brief Tests that ParallelFor visits every index exactly once.
+ */
+TEST_F(JobSystemTest, ParallelFor) {
+  tbge::jobs::JobSystem job_system(3);
+
+  for (size_t grain_size : {1, 7, 1000, 5000}) {
+    std::vector<std::atomic<int>> visits(1000);
+    tbge::jobs::ParallelFor(job_system, 0, visits.size(), grain_size,
+                            [&](size_t begin, size_t end) {
+                              EXPECT_LE(end - begin, grain_size);
+                              for (size_t i = begin; i < end; ++i) {
+                                visits[i].fetch_add(1);
+                              }
+                            });
+
+    for (size_t i = 0; i < visits.size(); ++i) {
+      EXPECT_EQ(visits[i].load(), 1)
+          << "Index " << i << " with grain size " << grain_size;
+    }
+  }
+
+  // Empty ranges call nothing
+  tbge::jobs::ParallelFor(job_system, 5, 5, 1, [](size_t, size_t) {
+    ADD_FAILURE() << "Called for an empty range.";
+  });
+}
+
+/**
+ * @brief Tests that a JobSystem without workers runs every task on the
+ * waiting thread in the order they were queued.
+ */
+TEST_F(JobSystemTest, NoWorkers) {
+  tbge::jobs::JobSystem job_system(0);
+
+  std::vector<int> order;
+  tbge::jobs::TaskGroup group(job_system);
+  for (int i = 0; i < 4; ++i) {
+    group.Run([&order, i] { order.push_back(i); });
+  }
+  EXPECT_EQ(group.get_pending_count(), 4);
+  group.Wait();
+
+  EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+}